@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    PanLfo.cpp
+    Created: 17 Oct 2026 9:12:40am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "PanLfo.h"
+
+namespace
+{
+    // The number of points in one cycle, this has to be a power of two.
+    constexpr int tableSize = 2048;
+    constexpr int tableMask = tableSize - 1;
+
+    // Builds one cycle of the left gain plus a guard point so the interpolation never wraps.
+    const std::array<float, tableSize + 1>& getPanLawTable()
+    {
+        static const auto panLawTable = []
+        {
+            std::array<float, tableSize + 1> newTable{};
+
+            for (int i = 0; i <= tableSize; ++i)
+            {
+                // Get a sine wave between 0 and 2 then scale it to an angle between 0 and pi / 2.
+                auto sinValue = std::sin ((2.0 * juce::double_Pi * i) / tableSize) + 1.0;
+                newTable[(size_t) i] = (float) std::cos ((sinValue * juce::double_Pi) / 4.0);
+            }
+
+            return newTable;
+        }();
+
+        return panLawTable;
+    }
+}
+
+//==============================================================================
+PanLfo::PanLfo()
+    : table (getPanLawTable().data())
+{
+}
+
+void PanLfo::prepare (int maximumBlockSize)
+{
+    gains.setSize (2, juce::jmax (1, maximumBlockSize));
+    doubleGains.setSize (2, juce::jmax (1, maximumBlockSize));
+}
+
+void PanLfo::reset() noexcept
+{
+    phase = 0.0;
+}
+
+void PanLfo::setPeriodInSamples (double numSamples) noexcept
+{
+    increment = 1.0 / juce::jmax (1.0, numSamples);
+}
+
+void PanLfo::setPhase (double newPhase) noexcept
+{
+    phase = newPhase - std::floor (newPhase);
+
+    // Rounding can leave a tiny negative phase exactly one cycle up.
+    if (phase >= 1.0)
+        phase = 0.0;
+}
+
+void PanLfo::advance (int numSamples) noexcept
+{
+    setPhase (phase + increment * numSamples);
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>& PanLfo::getGainBuffer() noexcept
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return doubleGains;
+    else
+        return gains;
+}
+
+template <typename SampleType>
+void PanLfo::process (SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    auto& gainBuffer = getGainBuffer<SampleType>();
+
+    // prepare() has to be called before any audio is processed.
+    jassert (gainBuffer.getNumSamples() > 0);
+
+    if (gainBuffer.getNumSamples() == 0)
+        return;
+
+    // Hosts are allowed to send bigger blocks than promised, so work through them in chunks.
+    while (numSamples > 0)
+    {
+        auto numThisTime = juce::jmin (numSamples, gainBuffer.getNumSamples());
+
+        renderGains (gainBuffer, numThisTime);
+
+        // The left channel follows the laws of Cos whereas the right channel follows the laws of sine.
+        juce::FloatVectorOperations::multiply (left, gainBuffer.getReadPointer (0), numThisTime);
+        juce::FloatVectorOperations::multiply (right, gainBuffer.getReadPointer (1), numThisTime);
+
+        left += numThisTime;
+        right += numThisTime;
+        numSamples -= numThisTime;
+    }
+}
+
+template <typename SampleType>
+void PanLfo::renderGains (juce::AudioBuffer<SampleType>& dest, int numSamples) noexcept
+{
+    auto* leftGains = dest.getWritePointer (0);
+    auto* rightGains = dest.getWritePointer (1);
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        // Find where the phase falls in the table and how far it is between two points.
+        auto position = (SampleType) (phase * tableSize);
+        auto truncated = (int) position;
+        auto fraction = position - (SampleType) truncated;
+
+        // Float rounding can land exactly on the end of the table, so mask it back into range.
+        auto index = truncated & tableMask;
+
+        // Left reads the table at the phase, right reads it half a cycle later.
+        auto rightIndex = (index + tableSize / 2) & tableMask;
+
+        leftGains[sample] = table[index] + fraction * (table[index + 1] - table[index]);
+        rightGains[sample] = table[rightIndex] + fraction * (table[rightIndex + 1] - table[rightIndex]);
+
+        // Increment the phase and wrap it back into a single cycle.
+        phase += increment;
+
+        if (phase >= 1.0)
+            phase -= 1.0;
+    }
+}
+
+//==============================================================================
+template void PanLfo::process<float> (float*, float*, int) noexcept;
+template void PanLfo::process<double> (double*, double*, int) noexcept;
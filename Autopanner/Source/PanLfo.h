@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    PanLfo.h
+    Created: 17 Oct 2026 9:12:40am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    A table driven LFO that produces the Autopanner's equal power pan gains.
+
+    Rather than calling std::sin and then std::cos and std::sin again for every
+    sample, the whole pan law, cos((sin(phase) + 1) * pi / 4) for the left channel,
+    is baked into one wavetable. The right channel gain is the same curve half a
+    cycle later, so both channels read from the same table.
+
+    Each block the gains are written into a buffer and then applied to the
+    channels with juce::FloatVectorOperations. The double precision path reads
+    the same table but interpolates and applies the gains in doubles.
+
+    The table has 2048 points per cycle and is linearly interpolated, which keeps
+    every gain within 1e-6 (-120 dB) of the std::sin / std::cos pan law. The table
+    is built once and shared by every instance, so each extra panner only costs
+    its own gain buffer.
+*/
+class PanLfo
+{
+public:
+    PanLfo();
+
+    /** Allocates the gain buffer, call this from prepareToPlay(). */
+    void prepare (int maximumBlockSize);
+
+    /** Sets the phase back to the start of the cycle. */
+    void reset() noexcept;
+
+    /** Sets how many samples one full left-right-left cycle takes. */
+    void setPeriodInSamples (double numSamples) noexcept;
+
+    /** Moves the LFO to a point in its cycle, in cycles. Anything outside 0 to 1 is wrapped. */
+    void setPhase (double newPhase) noexcept;
+
+    /** Where the LFO is in its cycle, between 0 and 1. */
+    double getPhase() const noexcept                      { return phase; }
+
+    /** How far the phase moves each sample, in cycles. */
+    double getIncrement() const noexcept                  { return increment; }
+
+    /** Moves the phase on by numSamples without rendering any gains, for when something else is doing the panning. */
+    void advance (int numSamples) noexcept;
+
+    /** Applies the pan gains to a pair of channels and advances the phase. Works on floats or doubles. */
+    template <typename SampleType>
+    void process (SampleType* left, SampleType* right, int numSamples) noexcept;
+
+private:
+    // Fills the gain buffer with the next numSamples left and right gains.
+    template <typename SampleType>
+    void renderGains (juce::AudioBuffer<SampleType>& dest, int numSamples) noexcept;
+
+    // The gain buffer for floats or doubles.
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getGainBuffer() noexcept;
+
+    // Points to the pan law table shared between all instances.
+    const float* table;
+
+    // Row 0 holds the left gains and row 1 the right gains for the current block, in each precision.
+    juce::AudioBuffer<float> gains;
+    juce::AudioBuffer<double> doubleGains;
+
+    // The phase is kept in cycles, between 0 and 1.
+    double phase = 0.0;
+    double increment = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PanLfo)
+};
@@ -8,6 +8,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "../../Shared/ProfiledGenericEditor.h"
 
 //==============================================================================
 AutopannerAudioProcessor::AutopannerAudioProcessor()
@@ -25,6 +26,28 @@ AutopannerAudioProcessor::AutopannerAudioProcessor()
     // Adds an Audio Parameter Float to gain with a default value of 0.5f
     addParameter(gain = new juce::AudioParameterFloat("GAIN", "Gain", 0.0f, 1.0f, 0.5f));
     addParameter(ms = new juce::AudioParameterFloat("MS", "ms", 10.0f, 5000.0f, 250.0f));
+
+    // The divisions are in the same order as the table in syncToHost().
+    addParameter(sync = new juce::AudioParameterBool("SYNC", "Tempo Sync", false));
+    addParameter(division = new juce::AudioParameterChoice("DIVISION", "Division", { "4 Bars", "2 Bars", "1 Bar", "1/2", "1/4", "1/8", "1/16",
+                                                                                     "1/4 Triplet", "1/8 Triplet", "1/4 Dotted", "1/8 Dotted" }, 2));
+
+    // Only used for layouts with more than two channels, stereo always uses the original pan law.
+    addParameter(panMode = new juce::AudioParameterChoice("PANMODE", "Surround Pan", { "Circular", "VBAP" }, 0));
+
+    // Only used for stereo. Middle C, or a velocity of 64, sweeps at the ms or synced rate.
+    addParameter(midiMode = new juce::AudioParameterChoice("MIDIMODE", "MIDI Voices", { "Off", "Note Rate", "Velocity Rate" }, 0));
+
+    // Built once every parameter exists, the values are worked out by parameter ID.
+    presets.setPresets({ { "Default", {} },
+                         { "Slow Sweep", { { "GAIN", 0.5f }, { "MS", 2000.0f } } },
+                         { "Fast Wobble", { { "GAIN", 0.5f }, { "MS", 60.0f } } },
+                         { "Quarter Note Sync", { { "GAIN", 0.5f }, { "SYNC", 1.0f }, { "DIVISION", 4.0f } } },
+                         { "Surround Orbit", { { "GAIN", 0.5f }, { "MS", 4000.0f }, { "PANMODE", 1.0f } } },
+                         { "Note Triggered", { { "GAIN", 0.5f }, { "MS", 1000.0f }, { "MIDIMODE", 1.0f } } } });
+
+    // The first general purpose controller moves the LFO's period.
+    splitter.setMappings({ { 16, ms } });
 }
 
 AutopannerAudioProcessor::~AutopannerAudioProcessor()
@@ -71,39 +94,63 @@ double AutopannerAudioProcessor::getTailLengthSeconds() const
 
 int AutopannerAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // The bank always has at least one, some hosts don't cope very well if you tell them there are 0 programs.
+    return presets.getNumPresets();
 }
 
 int AutopannerAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getCurrentPreset();
 }
 
 void AutopannerAudioProcessor::setCurrentProgram (int index)
 {
+    // The new values are picked up at the start of the next block.
+    presets.loadPreset(index);
 }
 
 const juce::String AutopannerAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getPresetName(index);
 }
 
 void AutopannerAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    // The factory presets can't be renamed.
 }
 
 //==============================================================================
 void AutopannerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    // The load is worked out against how long each block lasts at this rate.
+    profiler.prepare(sampleRate);
+
+    // From here on, presets wait for the start of a block.
+    presets.prepare();
+
+    // Allocate the LFO's gain buffer here so processBlock never has to.
+    lfo.prepare(samplesPerBlock);
+    lfo.reset();
+
+    // The surround panner's tables depend on where each speaker is, so they are built for the current layout.
+    surroundPanner.prepare(getChannelLayoutOfBus(false, 0), samplesPerBlock);
+
+    // The voices' scratch space and fade times, with no notes held.
+    voicePanner.prepare(sampleRate, samplesPerBlock);
+
+    // Multiplicative, so going from 10 to 20 ms takes as long as going from 1000 to 2000 ms.
+    smoothedPeriod.prepare(sampleRate, samplesPerBlock, 0.05, ParameterSmoother<float>::Mode::multiplicative);
+    smoothedPeriod.setCurrentAndTargetValue(ms->get());
+
+    // The pan gains only depend on the LFO's phase, so there is no tail to wait for once the input goes quiet.
+    silenceDetector.setTailLength(0);
+    silenceDetector.reset();
 }
 
 void AutopannerAudioProcessor::releaseResources()
 {
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
+    // There won't be any more blocks, so a preset that is still waiting is applied straight away.
+    presets.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -113,12 +160,17 @@ bool AutopannerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
+    // Mono, stereo, the common surround layouts and a first order ambisonic bed are supported.
     // Some plugin hosts, such as certain GarageBand versions, will only
     // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    const auto& output = layouts.getMainOutputChannelSet();
+
+    if (output != juce::AudioChannelSet::mono()
+     && output != juce::AudioChannelSet::stereo()
+     && output != juce::AudioChannelSet::create5point1()
+     && output != juce::AudioChannelSet::create7point1()
+     && output != juce::AudioChannelSet::create7point1point4()
+     && output != juce::AudioChannelSet::ambisonic(1))
         return false;
 
     // This checks if the input layout matches the output layout
@@ -134,65 +186,162 @@ bool AutopannerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 
 void AutopannerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    // Get a write pointer which can be accessed like an array to both channels.
-    auto* channelDataL = buffer.getWritePointer(0);
-    auto* channelDataR = buffer.getWritePointer(1);
+    BlockProfiler::ScopedTimer timer(profiler, buffer.getNumSamples());
 
-    // Get the value of the ms Float Param
-    float mSeconds = ms->get();
+    // Flushes denormals to zero for the rest of the block, so the pan gains and their smoothers never slow down near 0.
+    juce::ScopedNoDenormals noDenormals;
 
-    // Gets the value of the gain parameter.
-    float gSlider = gain->get();
+    presets.applyPendingValues();
 
-    // Gets the total amount of samples per second to go through.
-    int numberSamples = getSampleRate() * mSeconds;
+    // The synced phase comes from where the host is at the start of the block, so it is read once before the block is split.
+    if (sync->get())
+        syncToHost();
 
-    // Gets the total sampleRate
-    //const int numberSamples = getSampleRate();
+    // The notes are picked out of the block as the voices reach them, whichever part of the split they fall in.
+    voicePanner.beginBlock(midiMessages);
 
-    // How much to increment per sample in rads
-    const float radsPerSample = (2 * juce::double_Pi) / numberSamples;
+    if (skipSilentBlock(buffer, midiMessages))
+        return;
 
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-    {
-        // Get a sample from both channels
-        auto inputL = channelDataL[sample];
-        auto inputR = channelDataR[sample];
+    // A MIDI controller can move the period part way through, so each part between them is processed on its own.
+    splitter.process(buffer, midiMessages, [this](auto& subBlock) { processSamples(subBlock); });
+}
+
+void AutopannerAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // The same steps as the float version above.
+    BlockProfiler::ScopedTimer timer(profiler, buffer.getNumSamples());
+
+    juce::ScopedNoDenormals noDenormals;
+
+    presets.applyPendingValues();
+
+    if (sync->get())
+        syncToHost();
+
+    voicePanner.beginBlock(midiMessages);
+
+    if (skipSilentBlock(buffer, midiMessages))
+        return;
+
+    splitter.process(buffer, midiMessages, [this](auto& subBlock) { processSamples(subBlock); });
+}
+
+bool AutopannerAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+bool AutopannerAudioProcessor::skipSilentBlock(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages)
+{
+    // The whole block is checked at once, so the hold and tail don't depend on how controllers split it.
+    if (! silenceDetector.process(buffer))
+        return false;
 
-        // Create a sine wave of height 0.5 but then add 0.5 so it goes between 0 and 1
-        //float sinValue = 0.5f * std::sin(nextRad) + 0.5f;
+    // Nothing is panned, but the controllers in the block still take effect.
+    splitter.applyAll(midiMessages);
 
-        // Multiply the sample by the current sine value and its opposite.
-        //inputL = inputL * (1.0f - sinValue);
-        //inputR = inputR * sinValue;
+    // Panning silence gives silence, so an idle track skips the pan entirely. The LFO and the voices still move on
+    // by the whole block in one step, so the sweep is in the right place when audio comes back.
+    buffer.clear();
 
-        // Get a sine wave between 0 and 1
-        float sinValue = std::sin(nextRad) + 1.0f;
+    if (updateRate(buffer.getNumSamples(), buffer.getNumChannels()))
+        voicePanner.advance(buffer.getNumSamples());
 
-        // Get the sinValue
-        sinValue = (sinValue * juce::double_Pi) / 4.0f;
+    lfo.advance(buffer.getNumSamples());
+    return true;
+}
 
-        // The left channel follows the laws of Cos whereas the right channel follows the laws of sine.
-        inputL = inputL * std::cos(sinValue);
-        inputR = inputR * std::sin(sinValue);
+bool AutopannerAudioProcessor::updateRate(int numSamples, int numChannels)
+{
+    // Synced, the period was already set from the host's tempo at the start of the block.
+    if (! sync->get())
+    {
+        // Get the value of the ms Float Param. The phase never jumps, so moving the period once per block is smooth enough.
+        smoothedPeriod.setTargetValue(ms->get());
+        float mSeconds = smoothedPeriod.skip(numSamples);
 
-        // Mutiply the sample by the total amount of panning.
-        //inputL = inputL * (1.0f - gSlider);
-        //inputR = inputR * gSlider;
+        // Gets the total amount of samples one cycle of the LFO lasts for, the parameter is in milliseconds.
+        lfo.setPeriodInSamples(getSampleRate() * mSeconds / 1000.0);
+    }
 
-        // Output the modified samples
-        channelDataL[sample] = inputL;
-        channelDataR[sample] = inputR;
+    // The voices run at the LFO's rate scaled by each note. Without a MIDI mode, or with any layout but stereo, the notes are ignored.
+    auto useVoices = midiMode->getIndex() > 0 && numChannels == 2;
 
-        // Increment the nextRad by the amount of rads we need per sample.
-        nextRad += radsPerSample;
+    if (useVoices)
+    {
+        voicePanner.setRateSource(static_cast<VoicePanner::RateSource>(midiMode->getIndex() - 1));
+        voicePanner.setBaseIncrement(lfo.getIncrement());
     }
-    // When nextRad gets to be bigger than the total amount of samples per second...
-    if (nextRad > numberSamples)
+    else
     {
-        // Reset nextRad to 0.0f;
-        nextRad = 0.0f;
+        voicePanner.reset();
     }
+
+    return useVoices;
+}
+
+template <typename SampleType>
+void AutopannerAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    if (updateRate(buffer.getNumSamples(), buffer.getNumChannels()))
+    {
+        // Every held note's LFO is summed into one pan, then both channels are multiplied by its gains.
+        voicePanner.process(buffer.getWritePointer(0), buffer.getWritePointer(1), buffer.getNumSamples());
+        lfo.advance(buffer.getNumSamples());
+    }
+    else if (buffer.getNumChannels() == 2)
+    {
+        // The LFO fills a buffer of left and right gains and multiplies both channels by them in one go.
+        lfo.process(buffer.getWritePointer(0), buffer.getWritePointer(1), buffer.getNumSamples());
+    }
+    else
+    {
+        // Every other layout is swept by the surround panner, following the same LFO phase.
+        surroundPanner.setMode(static_cast<SurroundPanner::Mode>(panMode->getIndex()));
+        surroundPanner.process(buffer, lfo.getPhase(), lfo.getIncrement());
+        lfo.advance(buffer.getNumSamples());
+    }
+}
+
+void AutopannerAudioProcessor::syncToHost()
+{
+    // The length of each division in quarter notes, bars are worked out from the time signature below.
+    struct Division { double length; bool inBars; };
+
+    static constexpr Division divisions[] = { { 4.0, true }, { 2.0, true }, { 1.0, true }, { 2.0, false }, { 1.0, false },
+                                              { 0.5, false }, { 0.25, false }, { 2.0 / 3.0, false }, { 1.0 / 3.0, false },
+                                              { 1.5, false }, { 0.75, false } };
+
+    // If the host doesn't say, assume 120 bpm in 4/4.
+    double bpm = 120.0;
+    double quarterNotesPerBar = 4.0;
+    juce::Optional<double> ppqPosition;
+
+    if (auto* playHead = getPlayHead())
+    {
+        if (auto position = playHead->getPosition())
+        {
+            bpm = position->getBpm().orFallback(bpm);
+
+            if (auto timeSignature = position->getTimeSignature())
+                quarterNotesPerBar = 4.0 * timeSignature->numerator / juce::jmax(1, timeSignature->denominator);
+
+            if (position->getIsPlaying())
+                ppqPosition = position->getPpqPosition();
+        }
+    }
+
+    auto& chosen = divisions[juce::jlimit(0, (int) std::size(divisions) - 1, division->getIndex())];
+    auto quarterNotesPerCycle = chosen.inBars ? chosen.length * quarterNotesPerBar : chosen.length;
+
+    lfo.setPeriodInSamples(getSampleRate() * quarterNotesPerCycle * 60.0 / juce::jmax(1.0, bpm));
+
+    // The phase is taken straight from the host's position every block rather than accumulated,
+    // so it stays locked to the beat however long the session runs. When stopped the LFO runs free at the same rate.
+    if (ppqPosition.hasValue())
+        lfo.setPhase(*ppqPosition / quarterNotesPerCycle);
 }
 
 //==============================================================================
@@ -205,22 +354,21 @@ juce::AudioProcessorEditor* AutopannerAudioProcessor::createEditor()
 {
     //return new AutopannerAudioProcessorEditor (*this);
 
-    // Adds a default JUCE style interface.
-    return new juce::GenericAudioProcessorEditor(this);
+    // Adds a default JUCE style interface, with the profiler's figures underneath.
+    return new ProfiledGenericEditor(*this, profiler);
 }
 
 //==============================================================================
 void AutopannerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    // Every parameter by ID with its real value, and the preset that was loaded.
+    presets.saveState(stateVersion, destData);
 }
 
 void AutopannerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    // An empty state, from before there was any, leaves the parameters as they are rather than resetting them.
+    presets.restoreState(data, sizeInBytes, stateVersion);
 }
 
 //==============================================================================
@@ -9,6 +9,14 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "PanLfo.h"
+#include "SurroundPanner.h"
+#include "VoicePanner.h"
+#include "../../Shared/ParameterSmoother.h"
+#include "../../Shared/BlockProfiler.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
+#include "../../Shared/BlockSplitter.h"
 
 //==============================================================================
 /**
@@ -32,6 +40,10 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    // The panners work on doubles as well, so 64 bit hosts don't have to convert each block to floats.
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -56,11 +68,64 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    // How long each processBlock call takes, for the editor to show.
+    BlockProfiler& getProfiler() noexcept { return profiler; }
+
 private:
     juce::AudioParameterFloat* gain;
     juce::AudioParameterFloat* ms;
 
-    float nextRad = 0.0f;
+    // When sync is on the LFO follows the host's tempo and position instead of ms.
+    juce::AudioParameterBool* sync;
+    juce::AudioParameterChoice* division;
+
+    // How the sweep is shared out between the speakers of a surround layout.
+    juce::AudioParameterChoice* panMode;
+
+    // Off runs the one free LFO, the others give each held MIDI note its own LFO with the rate set by the note or its velocity.
+    juce::AudioParameterChoice* midiMode;
+
+    // Pans one part of the block between controllers, for either precision.
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // Checks the whole block for silence before it is split. A silent block is cleared and the LFO and voices only move on.
+    template <typename SampleType>
+    bool skipSilentBlock(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages);
+
+    // Moves the free running period on by numSamples and sets up the voices. Returns true if the voices do the panning.
+    bool updateRate(int numSamples, int numChannels);
+
+    // Works out the LFO period and, while the host is playing, its phase from the host's position.
+    void syncToHost();
+
+    // Generates the pan gains for each block.
+    PanLfo lfo;
+
+    // Pans mono and anything wider than stereo, using the LFO's phase.
+    SurroundPanner surroundPanner;
+
+    // Pans stereo with one LFO per held note in the MIDI modes.
+    VoicePanner voicePanner;
+
+    // Glides the LFO period to each new ms value.
+    ParameterSmoother<float> smoothedPeriod;
+
+    // Skips the pan while the input is silent, only moving the LFO on.
+    SilenceDetector silenceDetector;
+
+    // Cuts each block wherever a MIDI controller moves a parameter, so the change lands on the right sample.
+    BlockSplitter splitter;
+
+    // Times every processBlock call without locking or allocating on the audio thread.
+    BlockProfiler profiler;
+
+    // The factory presets. Presets and restored sessions are applied all at once at the start of a block.
+    PresetBank presets { *this };
+
+    // Bump this, and pass a migration to restoreState(), when a change needs more than new parameters getting their defaults.
+    static constexpr int stateVersion = 1;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutopannerAudioProcessor)
 };
@@ -0,0 +1,351 @@
+/*
+  ==============================================================================
+
+    SurroundPanner.cpp
+    Created: 17 Oct 2026 7:02:18pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "SurroundPanner.h"
+
+namespace
+{
+    // The number of points in one cycle, this has to be a power of two.
+    constexpr int gainTableSize = 1024;
+    constexpr int gainTableMask = gainTableSize - 1;
+
+    // Rows of the scratch buffer.
+    enum { fractionRow = 0, gainRow, sinRow, copyRow, numScratchRows };
+
+    // Where a speaker sits, in degrees with positive to the left, and whether it is swept at all.
+    struct SpeakerPosition
+    {
+        bool isSwept = false;
+        bool isHeight = false;
+        double azimuth = 0.0;
+    };
+
+    SpeakerPosition getSpeakerPosition (juce::AudioChannelSet::ChannelType type)
+    {
+        using Type = juce::AudioChannelSet;
+
+        switch (type)
+        {
+            case Type::left:                return { true, false, 30.0 };
+            case Type::right:               return { true, false, -30.0 };
+            case Type::centre:              return { true, false, 0.0 };
+            case Type::leftCentre:          return { true, false, 15.0 };
+            case Type::rightCentre:         return { true, false, -15.0 };
+            case Type::wideLeft:            return { true, false, 60.0 };
+            case Type::wideRight:           return { true, false, -60.0 };
+            case Type::leftSurroundSide:    return { true, false, 90.0 };
+            case Type::rightSurroundSide:   return { true, false, -90.0 };
+            case Type::leftSurround:        return { true, false, 110.0 };
+            case Type::rightSurround:       return { true, false, -110.0 };
+            case Type::leftSurroundRear:    return { true, false, 150.0 };
+            case Type::rightSurroundRear:   return { true, false, -150.0 };
+            case Type::centreSurround:      return { true, false, 180.0 };
+            case Type::topFrontLeft:        return { true, true, 45.0 };
+            case Type::topFrontRight:       return { true, true, -45.0 };
+            case Type::topFrontCentre:      return { true, true, 0.0 };
+            case Type::topSideLeft:         return { true, true, 90.0 };
+            case Type::topSideRight:        return { true, true, -90.0 };
+            case Type::topRearLeft:         return { true, true, 135.0 };
+            case Type::topRearRight:        return { true, true, -135.0 };
+            case Type::topRearCentre:       return { true, true, 180.0 };
+
+            // The LFE, the speaker straight overhead and anything unknown are left alone.
+            default:                        return {};
+        }
+    }
+
+    double wrapAngle (double angle)
+    {
+        angle = std::fmod (angle, juce::MathConstants<double>::twoPi);
+        return angle < 0.0 ? angle + juce::MathConstants<double>::twoPi : angle;
+    }
+
+    //==============================================================================
+    // A ring of speakers at the same height, sorted by angle.
+    struct Ring
+    {
+        std::vector<int> channels;
+        std::vector<double> angles;
+    };
+
+    // Every speaker gets 0.5 + 0.5 * cos of its angle from the source.
+    void getCircularGains (const Ring& ring, double source, std::vector<double>& gains)
+    {
+        // A lone speaker, such as mono's centre, has nowhere to pan to. Its cosine would reach 0 opposite it.
+        if (ring.angles.size() == 1)
+        {
+            gains[0] = 1.0;
+            return;
+        }
+
+        for (size_t i = 0; i < ring.angles.size(); ++i)
+            gains[i] = 0.5 + 0.5 * std::cos (source - ring.angles[i]);
+    }
+
+    // Only the pair of speakers either side of the source, solved as in 2D VBAP.
+    void getVbapGains (const Ring& ring, double source, std::vector<double>& gains)
+    {
+        std::fill (gains.begin(), gains.end(), 0.0);
+
+        auto numSpeakers = ring.angles.size();
+
+        if (numSpeakers == 1)
+        {
+            gains[0] = 1.0;
+            return;
+        }
+
+        for (size_t a = 0; a < numSpeakers; ++a)
+        {
+            auto b = (a + 1) % numSpeakers;
+
+            // The arc from speaker a round to speaker b, going the way the angles increase.
+            auto arc = wrapAngle (ring.angles[b] - ring.angles[a]);
+            auto offset = wrapAngle (source - ring.angles[a]);
+
+            if (arc == 0.0)
+                arc = juce::MathConstants<double>::twoPi;
+
+            if (offset > arc)
+                continue;
+
+            // VBAP needs the two speakers to be less than half a circle apart, which isn't
+            // true of a stereo pair going round the back. Those get a constant power crossfade.
+            if (arc < juce::MathConstants<double>::pi * 0.95)
+            {
+                gains[a] = std::sin (arc - offset) / std::sin (arc);
+                gains[b] = std::sin (offset) / std::sin (arc);
+            }
+            else
+            {
+                auto fraction = offset / arc;
+                gains[a] = std::cos (fraction * juce::MathConstants<double>::halfPi);
+                gains[b] = std::sin (fraction * juce::MathConstants<double>::halfPi);
+            }
+
+            return;
+        }
+    }
+
+    // Fills each ring channel's table row with its gain for every source angle round the circle.
+    template <typename GainFunction>
+    void buildTables (const Ring& ring, const std::vector<int>& tableRows, juce::AudioBuffer<float>& tables, GainFunction&& getGains)
+    {
+        std::vector<double> gains (ring.angles.size());
+
+        for (int point = 0; point <= gainTableSize; ++point)
+        {
+            getGains (ring, juce::MathConstants<double>::twoPi * point / gainTableSize, gains);
+
+            // Scale the gains so the ring's total power is the same wherever the source is.
+            auto power = 0.0;
+
+            for (auto gain : gains)
+                power += gain * gain;
+
+            auto scale = power > 0.0 ? 1.0 / std::sqrt (power) : 0.0;
+
+            for (size_t i = 0; i < gains.size(); ++i)
+                tables.setSample (tableRows[(size_t) ring.channels[i]], point, (float) (gains[i] * scale));
+        }
+    }
+}
+
+//==============================================================================
+void SurroundPanner::prepare (const juce::AudioChannelSet& layout, int maximumBlockSize)
+{
+    maxBlockSize = juce::jmax (1, maximumBlockSize);
+    indices.resize ((size_t) maxBlockSize);
+    scratch.setSize (numScratchRows, maxBlockSize);
+    doubleScratch.setSize (numScratchRows, maxBlockSize);
+
+    auto numChannels = layout.size();
+    tableRows.assign ((size_t) numChannels, -1);
+    ambisonicX = ambisonicY = -1;
+
+    // A first order ambisonic bed is rotated, there are no speakers to sweep between.
+    if (layout.getAmbisonicOrder() == 1)
+    {
+        ambisonicX = layout.getChannelIndexForType (juce::AudioChannelSet::ambisonicX);
+        ambisonicY = layout.getChannelIndexForType (juce::AudioChannelSet::ambisonicY);
+
+        rotationTables.setSize (2, gainTableSize + 1);
+
+        for (int point = 0; point <= gainTableSize; ++point)
+        {
+            auto angle = juce::MathConstants<double>::twoPi * point / gainTableSize;
+            rotationTables.setSample (0, point, (float) std::cos (angle));
+            rotationTables.setSample (1, point, (float) std::sin (angle));
+        }
+
+        return;
+    }
+
+    // Split the speakers into the ear level ring and the height ring.
+    Ring rings[2];
+    int numSwept = 0;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto position = getSpeakerPosition (layout.getTypeOfChannel (channel));
+
+        if (! position.isSwept)
+            continue;
+
+        auto& ring = rings[position.isHeight ? 1 : 0];
+        ring.channels.push_back (channel);
+        ring.angles.push_back (wrapAngle (juce::degreesToRadians (position.azimuth)));
+        tableRows[(size_t) channel] = numSwept++;
+    }
+
+    circularTables.setSize (juce::jmax (1, numSwept), gainTableSize + 1);
+    vbapTables.setSize (juce::jmax (1, numSwept), gainTableSize + 1);
+
+    for (auto& ring : rings)
+    {
+        if (ring.channels.empty())
+            continue;
+
+        // VBAP works with neighbouring speakers, so put each ring in order round the circle.
+        std::vector<std::pair<double, int>> order;
+
+        for (size_t i = 0; i < ring.channels.size(); ++i)
+            order.push_back ({ ring.angles[i], ring.channels[i] });
+
+        std::sort (order.begin(), order.end());
+
+        Ring sorted;
+
+        for (auto& [angle, channel] : order)
+        {
+            sorted.channels.push_back (channel);
+            sorted.angles.push_back (angle);
+        }
+
+        buildTables (sorted, tableRows, circularTables, getCircularGains);
+        buildTables (sorted, tableRows, vbapTables, getVbapGains);
+    }
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>& SurroundPanner::getScratch() noexcept
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return doubleScratch;
+    else
+        return scratch;
+}
+
+template <typename SampleType>
+void SurroundPanner::process (juce::AudioBuffer<SampleType>& buffer, double startPhase, double increment) noexcept
+{
+    // prepare() has to be called before any audio is processed.
+    jassert (maxBlockSize > 0);
+
+    if (maxBlockSize == 0)
+        return;
+
+    auto phase = startPhase - std::floor (startPhase);
+
+    // The table positions and gains are only sized for maxBlockSize samples at a time.
+    for (int start = 0; start < buffer.getNumSamples(); start += maxBlockSize)
+    {
+        auto numSamples = juce::jmin (maxBlockSize, buffer.getNumSamples() - start);
+
+        findTablePositions (numSamples, phase, increment);
+
+        if (ambisonicX >= 0 && ambisonicY >= 0)
+            processAmbisonic (buffer, start, numSamples);
+        else
+            processSpeakers (buffer, start, numSamples);
+    }
+}
+
+void SurroundPanner::findTablePositions (int numSamples, double& phase, double increment) noexcept
+{
+    auto* fractions = scratch.getWritePointer (fractionRow);
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        auto position = phase * gainTableSize;
+        auto truncated = (int) position;
+
+        // Float rounding can land exactly on the end of the table, so mask it back into range.
+        indices[(size_t) sample] = truncated & gainTableMask;
+        fractions[sample] = (float) (position - truncated);
+
+        phase += increment;
+
+        if (phase >= 1.0)
+            phase -= 1.0;
+    }
+}
+
+template <typename SampleType>
+void SurroundPanner::readTable (const float* table, SampleType* dest, int numSamples) const noexcept
+{
+    auto* fractions = scratch.getReadPointer (fractionRow);
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        auto index = indices[(size_t) sample];
+        dest[sample] = table[index] + fractions[sample] * (table[index + 1] - table[index]);
+    }
+}
+
+template <typename SampleType>
+void SurroundPanner::processSpeakers (juce::AudioBuffer<SampleType>& buffer, int start, int numSamples) noexcept
+{
+    auto& tables = mode == Mode::circular ? circularTables : vbapTables;
+    auto* gains = getScratch<SampleType>().getWritePointer (gainRow);
+    auto numChannels = juce::jmin (buffer.getNumChannels(), (int) tableRows.size());
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto row = tableRows[(size_t) channel];
+
+        if (row < 0)
+            continue;
+
+        readTable (tables.getReadPointer (row), gains, numSamples);
+        juce::FloatVectorOperations::multiply (buffer.getWritePointer (channel, start), gains, numSamples);
+    }
+}
+
+template <typename SampleType>
+void SurroundPanner::processAmbisonic (juce::AudioBuffer<SampleType>& buffer, int start, int numSamples) noexcept
+{
+    if (juce::jmax (ambisonicX, ambisonicY) >= buffer.getNumChannels())
+        return;
+
+    auto& rows = getScratch<SampleType>();
+    auto* cosines = rows.getWritePointer (gainRow);
+    auto* sines = rows.getWritePointer (sinRow);
+    auto* originalX = rows.getWritePointer (copyRow);
+
+    readTable (rotationTables.getReadPointer (0), cosines, numSamples);
+    readTable (rotationTables.getReadPointer (1), sines, numSamples);
+
+    auto* x = buffer.getWritePointer (ambisonicX, start);
+    auto* y = buffer.getWritePointer (ambisonicY, start);
+
+    // x' = x cos - y sin, y' = x sin + y cos. W and Z don't change when turning round the vertical axis.
+    juce::FloatVectorOperations::copy (originalX, x, numSamples);
+
+    juce::FloatVectorOperations::multiply (x, cosines, numSamples);
+    juce::FloatVectorOperations::subtractWithMultiply (x, y, sines, numSamples);
+
+    juce::FloatVectorOperations::multiply (y, cosines, numSamples);
+    juce::FloatVectorOperations::addWithMultiply (y, originalX, sines, numSamples);
+}
+
+//==============================================================================
+template void SurroundPanner::process<float> (juce::AudioBuffer<float>&, double, double) noexcept;
+template void SurroundPanner::process<double> (juce::AudioBuffer<double>&, double, double) noexcept;
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    SurroundPanner.h
+    Created: 17 Oct 2026 7:02:18pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Sweeps the Autopanner around a whole speaker layout rather than just left and
+    right.
+
+    The LFO's phase is turned into an angle going once around the listener per
+    cycle, and each speaker is turned up as the angle passes it. Ear level and
+    height speakers are treated as two rings that sweep together. The LFE and any
+    speaker without a position are left alone.
+
+    There are two ways of sharing the signal between the speakers:
+     - circular gives every speaker a smooth cardioid shaped share, so the sweep
+       is soft and never fully leaves any speaker.
+     - vbap only uses the two speakers either side of the angle, as in vector base
+       amplitude panning, so the sweep is focused.
+    Both keep the total power of each ring constant.
+
+    A first order ambisonic bed is rotated around the vertical axis instead.
+
+    Each speaker's gain over one cycle is worked out in prepare() and stored in a
+    table, like the stereo PanLfo. Each block the table positions are found once
+    and shared by every channel, then each channel is multiplied by its gains with
+    FloatVectorOperations, one channel after another. Buffers of floats and
+    doubles are both supported, the tables themselves are floats.
+*/
+class SurroundPanner
+{
+public:
+    enum class Mode
+    {
+        circular = 0,
+        vbap
+    };
+
+    SurroundPanner() = default;
+
+    /** Builds the gain tables for the layout and allocates the block buffers, call this from prepareToPlay(). */
+    void prepare (const juce::AudioChannelSet& layout, int maximumBlockSize);
+
+    void setMode (Mode newMode) noexcept                     { mode = newMode; }
+
+    /** Applies the sweep to every channel of the buffer, starting at startPhase (in cycles)
+        and moving on by increment each sample. This doesn't keep a phase of its own,
+        the caller does that.
+    */
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>& buffer, double startPhase, double increment) noexcept;
+
+private:
+    // Finds the table position of every sample in the chunk, which every channel then shares.
+    void findTablePositions (int numSamples, double& phase, double increment) noexcept;
+
+    // Reads one table at the positions found by findTablePositions() into dest.
+    template <typename SampleType>
+    void readTable (const float* table, SampleType* dest, int numSamples) const noexcept;
+
+    template <typename SampleType>
+    void processSpeakers (juce::AudioBuffer<SampleType>& buffer, int start, int numSamples) noexcept;
+
+    template <typename SampleType>
+    void processAmbisonic (juce::AudioBuffer<SampleType>& buffer, int start, int numSamples) noexcept;
+
+    // The scratch space the gains are written into, for floats or doubles.
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getScratch() noexcept;
+
+    // The gain tables for every channel, one row per channel, for each mode.
+    // A channel that isn't swept has no row, and its index in tableRows is -1.
+    juce::AudioBuffer<float> circularTables, vbapTables;
+    std::vector<int> tableRows;
+
+    // The ambisonic rotation, a cosine and a sine table and the channels being rotated.
+    juce::AudioBuffer<float> rotationTables;
+    int ambisonicX = -1, ambisonicY = -1;
+
+    // Per block scratch space. The table fractions always live in the float scratch,
+    // the gains go in whichever matches the buffer being processed.
+    std::vector<int> indices;
+    juce::AudioBuffer<float> scratch;
+    juce::AudioBuffer<double> doubleScratch;
+
+    Mode mode = Mode::circular;
+    int maxBlockSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SurroundPanner)
+};
@@ -0,0 +1,357 @@
+/*
+  ==============================================================================
+
+    VoicePanner.cpp
+    Created: 18 Oct 2026 1:49:22am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "VoicePanner.h"
+#include "../../Shared/SimdOps.h"
+
+namespace
+{
+    // Rows of the scratch buffer.
+    enum { panRow = 0, leftGainRow, rightGainRow, numVoiceScratchRows };
+
+    // Short enough to keep a retrigger tight, long enough not to click.
+    constexpr double voiceAttackSeconds = 0.005;
+    constexpr double voiceReleaseSeconds = 0.1;
+
+    /** sin (2 pi phase) for a phase between 0 and 1, within 0.0011 of std::sin.
+
+        This is a parabola through the peaks and zero crossings with one correction
+        term on top, which only needs a multiply, an add and an abs per step so it
+        runs on every lane at once.
+    */
+    template <typename Ops>
+    inline typename Ops::Vec sineOfPhase (typename Ops::Vec phase) noexcept
+    {
+        using Sample = typename Ops::Sample;
+
+        // sin (2 pi phase) is sin (pi t) with t running from 1 down to -1.
+        auto t = Ops::sub (Ops::set ((Sample) 1), Ops::add (phase, phase));
+        auto y = Ops::mul (Ops::mul (Ops::set ((Sample) 4), t), Ops::sub (Ops::set ((Sample) 1), Ops::abs (t)));
+
+        return Ops::add (y, Ops::mul (Ops::set ((Sample) 0.225), Ops::sub (Ops::mul (y, Ops::abs (y)), y)));
+    }
+
+    // Adds up the lanes of a register.
+    template <typename Ops>
+    inline float sumLanes (typename Ops::Vec value) noexcept
+    {
+        std::array<float, Ops::width> lanes;
+        Ops::store (lanes.data(), value);
+
+        float sum = 0.0f;
+
+        for (auto lane : lanes)
+            sum += lane;
+
+        return sum;
+    }
+}
+
+//==============================================================================
+void VoicePanner::prepare (double sampleRate, int maximumBlockSize)
+{
+    scratch.setSize (numVoiceScratchRows, juce::jmax (1, maximumBlockSize));
+
+    attackSlope = (float) (1.0 / (voiceAttackSeconds * sampleRate));
+    releaseSlope = (float) (-1.0 / (voiceReleaseSeconds * sampleRate));
+
+    reset();
+}
+
+void VoicePanner::reset() noexcept
+{
+    for (auto* lanes : { &phases, &increments, &ratios, &levels, &slopes })
+        lanes->fill (0.0f);
+
+    notes.fill (-1);
+    numActiveVoices = 0;
+    blockMidi = nullptr;
+    blockPosition = 0;
+}
+
+void VoicePanner::setBaseIncrement (double newIncrement) noexcept
+{
+    baseIncrement = newIncrement;
+
+    for (int voice = 0; voice < numActiveVoices; ++voice)
+        increments[(size_t) voice] = (float) (baseIncrement * ratios[(size_t) voice]);
+}
+
+void VoicePanner::beginBlock (const juce::MidiBuffer& midiMessages) noexcept
+{
+    blockMidi = &midiMessages;
+    blockPosition = 0;
+}
+
+//==============================================================================
+float VoicePanner::getRatio (int note, int velocity) const noexcept
+{
+    // Middle C, or a velocity of 64, runs at the Autopanner's own rate.
+    if (rateSource == RateSource::velocity)
+        return std::exp2 ((float) (velocity - 64) / 32.0f);
+
+    return std::exp2 ((float) (note - 60) / 12.0f);
+}
+
+void VoicePanner::startVoice (int note, int velocity) noexcept
+{
+    int voice = 0;
+
+    // The same note again restarts its voice, from however loud it already is so it doesn't click.
+    while (voice < numActiveVoices && notes[(size_t) voice] != note)
+        ++voice;
+
+    if (voice == numActiveVoices)
+    {
+        if (numActiveVoices < maxVoices)
+        {
+            ++numActiveVoices;
+            levels[(size_t) voice] = 0.0f;
+        }
+        else
+        {
+            // Every voice is playing, so the quietest one makes way.
+            voice = (int) std::distance (levels.begin(), std::min_element (levels.begin(), levels.end()));
+        }
+    }
+
+    auto index = (size_t) voice;
+    notes[index] = note;
+    phases[index] = 0.0f;
+    ratios[index] = getRatio (note, velocity);
+    increments[index] = (float) (baseIncrement * ratios[index]);
+    slopes[index] = attackSlope;
+}
+
+void VoicePanner::releaseVoice (int note) noexcept
+{
+    for (int voice = 0; voice < numActiveVoices; ++voice)
+        if (notes[(size_t) voice] == note)
+            slopes[(size_t) voice] = releaseSlope;
+}
+
+void VoicePanner::removeFinishedVoices() noexcept
+{
+    for (int voice = numActiveVoices - 1; voice >= 0; --voice)
+    {
+        auto index = (size_t) voice;
+
+        if (slopes[index] >= 0.0f || levels[index] > 0.0f)
+            continue;
+
+        // The last playing voice fills the gap, keeping the playing ones packed at the front.
+        auto last = (size_t) --numActiveVoices;
+
+        for (auto* lanes : { &phases, &increments, &ratios, &levels, &slopes })
+        {
+            (*lanes)[index] = (*lanes)[last];
+            (*lanes)[last] = 0.0f;
+        }
+
+        notes[index] = notes[last];
+        notes[last] = -1;
+    }
+}
+
+void VoicePanner::handleMessage (const juce::MidiMessage& message) noexcept
+{
+    if (message.isNoteOn())
+    {
+        startVoice (message.getNoteNumber(), message.getVelocity());
+    }
+    else if (message.isNoteOff())
+    {
+        releaseVoice (message.getNoteNumber());
+    }
+    else if (message.isAllNotesOff() || message.isAllSoundOff())
+    {
+        for (int voice = 0; voice < numActiveVoices; ++voice)
+            slopes[(size_t) voice] = releaseSlope;
+    }
+}
+
+template <typename SegmentFunction>
+void VoicePanner::forEachSegment (int numSamples, SegmentFunction&& renderSegment) noexcept
+{
+    auto end = blockPosition + numSamples;
+    int done = 0;
+
+    if (blockMidi != nullptr)
+    {
+        for (auto it = blockMidi->findNextSamplePosition (blockPosition); it != blockMidi->end(); ++it)
+        {
+            const auto metadata = *it;
+
+            if (metadata.samplePosition >= end)
+                break;
+
+            auto offset = juce::jmax (0, metadata.samplePosition - blockPosition);
+
+            if (offset > done)
+            {
+                renderSegment (done, offset - done);
+                done = offset;
+            }
+
+            handleMessage (metadata.getMessage());
+        }
+    }
+
+    if (done < numSamples)
+        renderSegment (done, numSamples - done);
+
+    blockPosition = end;
+}
+
+//==============================================================================
+template <typename Ops>
+void VoicePanner::renderPan (float* pan, int numSamples) noexcept
+{
+    // Only the registers holding playing voices are worked through.
+    const auto numLanes = ((numActiveVoices + Ops::width - 1) / Ops::width) * Ops::width;
+    const auto zero = Ops::set (0.0f);
+    const auto one = Ops::set (1.0f);
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        auto panSum = zero;
+        auto levelSum = zero;
+
+        for (int lane = 0; lane < numLanes; lane += Ops::width)
+        {
+            auto phase = Ops::load (phases.data() + lane);
+            auto level = Ops::load (levels.data() + lane);
+
+            panSum = Ops::add (panSum, Ops::mul (sineOfPhase<Ops> (phase), level));
+            levelSum = Ops::add (levelSum, level);
+
+            // Move the phase on and wrap it, and move the fade on, keeping it between silent and full.
+            phase = Ops::add (phase, Ops::load (increments.data() + lane));
+            phase = Ops::sub (phase, Ops::select (Ops::greaterThan (phase, one), one, zero));
+            level = Ops::min (Ops::max (Ops::add (level, Ops::load (slopes.data() + lane)), zero), one);
+
+            Ops::store (phases.data() + lane, phase);
+            Ops::store (levels.data() + lane, level);
+        }
+
+        // Past a total level of one the voices are averaged, below it a fading voice pulls the pan towards the centre.
+        pan[sample] = sumLanes<Ops> (panSum) / juce::jmax (1.0f, sumLanes<Ops> (levelSum));
+    }
+}
+
+template <typename Ops>
+int VoicePanner::renderGainLanes (const float* pan, float* leftGains, float* rightGains, int numSamples) const noexcept
+{
+    // The same equal power law as PanLfo. With b = pan * pi / 4, left is cos (pi / 4 + b) and right is sin (pi / 4 + b),
+    // which come out of sin b and cos b. b is never more than pi / 4, so short Taylor series keep the gains within 1e-6.
+    const auto quarterPi = Ops::set (juce::MathConstants<float>::pi / 4.0f);
+    const auto rootHalf = Ops::set (juce::MathConstants<float>::sqrt2 / 2.0f);
+    const auto one = Ops::set (1.0f);
+
+    int sample = 0;
+
+    for (; sample + Ops::width <= numSamples; sample += Ops::width)
+    {
+        auto b = Ops::mul (Ops::load (pan + sample), quarterPi);
+        auto b2 = Ops::mul (b, b);
+
+        auto sinB = Ops::add (Ops::set (1.0f / 120.0f), Ops::mul (b2, Ops::set (-1.0f / 5040.0f)));
+        sinB = Ops::add (Ops::set (-1.0f / 6.0f), Ops::mul (b2, sinB));
+        sinB = Ops::mul (b, Ops::add (one, Ops::mul (b2, sinB)));
+
+        auto cosB = Ops::add (Ops::set (-1.0f / 720.0f), Ops::mul (b2, Ops::set (1.0f / 40320.0f)));
+        cosB = Ops::add (Ops::set (1.0f / 24.0f), Ops::mul (b2, cosB));
+        cosB = Ops::add (Ops::set (-0.5f), Ops::mul (b2, cosB));
+        cosB = Ops::add (one, Ops::mul (b2, cosB));
+
+        Ops::store (leftGains + sample, Ops::mul (Ops::sub (cosB, sinB), rootHalf));
+        Ops::store (rightGains + sample, Ops::mul (Ops::add (cosB, sinB), rootHalf));
+    }
+
+    return sample;
+}
+
+template <typename SampleType>
+void VoicePanner::process (SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    // prepare() has to be called before any audio is processed.
+    jassert (scratch.getNumSamples() > 0);
+
+    if (scratch.getNumSamples() == 0)
+        return;
+
+    forEachSegment (numSamples, [&] (int offset, int length)
+    {
+        // The scratch rows hold one prepared block, as with PanLfo's gain buffer.
+        while (length > 0)
+        {
+            auto numThisTime = juce::jmin (length, scratch.getNumSamples());
+            auto* pan = scratch.getWritePointer (panRow);
+            auto* leftGains = scratch.getWritePointer (leftGainRow);
+            auto* rightGains = scratch.getWritePointer (rightGainRow);
+
+            if (numActiveVoices == 0)
+            {
+                // With nothing playing the pan sits in the centre, so there are no voices to sum.
+                juce::FloatVectorOperations::clear (pan, numThisTime);
+            }
+            else
+            {
+                renderPan<SimdOps::Native> (pan, numThisTime);
+                removeFinishedVoices();
+            }
+
+            auto done = renderGainLanes<SimdOps::Native> (pan, leftGains, rightGains, numThisTime);
+
+            if (done < numThisTime)
+                renderGainLanes<SimdOps::Scalar> (pan + done, leftGains + done, rightGains + done, numThisTime - done);
+
+            // The gains are worked out in floats either way, a double buffer just widens them as they are applied.
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                juce::FloatVectorOperations::multiply (left + offset, leftGains, numThisTime);
+                juce::FloatVectorOperations::multiply (right + offset, rightGains, numThisTime);
+            }
+            else
+            {
+                for (int sample = 0; sample < numThisTime; ++sample)
+                {
+                    left[offset + sample] *= (SampleType) leftGains[sample];
+                    right[offset + sample] *= (SampleType) rightGains[sample];
+                }
+            }
+
+            offset += numThisTime;
+            length -= numThisTime;
+        }
+    });
+}
+
+void VoicePanner::advance (int numSamples) noexcept
+{
+    // Each phase and fade moves in a straight line, so every voice jumps straight to where it would have got to.
+    forEachSegment (numSamples, [this] (int, int length)
+    {
+        for (int voice = 0; voice < numActiveVoices; ++voice)
+        {
+            auto index = (size_t) voice;
+            auto phase = phases[index] + increments[index] * (float) length;
+
+            phases[index] = phase - std::floor (phase);
+            levels[index] = juce::jlimit (0.0f, 1.0f, levels[index] + slopes[index] * (float) length);
+        }
+
+        removeFinishedVoices();
+    });
+}
+
+//==============================================================================
+template void VoicePanner::process<float> (float*, float*, int) noexcept;
+template void VoicePanner::process<double> (double*, double*, int) noexcept;
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    VoicePanner.h
+    Created: 18 Oct 2026 1:49:22am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Pans a stereo pair with one LFO per held MIDI note, for the Autopanner's MIDI
+    modes.
+
+    Every note-on starts a voice with its LFO at the start of its cycle, or
+    restarts the voice if that note is already playing. The voice's rate is the
+    Autopanner's rate scaled by the note number, an octave up doubling it, or by
+    the velocity, every 32 steps doubling it. Each voice fades in over a few
+    milliseconds while the note is held and fades out after it is released. The
+    pan is the voices' sweeps averaged by how loud each one is, so a lone voice
+    sweeps just like the free running LFO and the pan sits in the centre with no
+    notes held.
+
+    Up to 16 voices are kept as a structure of arrays, one array per value, with
+    the playing voices packed at the front. Each sample, the voices are worked
+    through in SIMD registers, four or eight at a time, so one voice costs one
+    register's worth and 16 cost a few more, rather than 16 LFOs. The pan law is
+    then worked out for the whole block in a second SIMD pass and applied to both
+    channels with FloatVectorOperations, just as PanLfo does.
+
+    The notes are read from the block's MIDI as each sample is reached, so a
+    retrigger lands on the sample its note-on was sent for, however the block has
+    been split up.
+*/
+class VoicePanner
+{
+public:
+    /** What sets the rate of each voice. */
+    enum class RateSource
+    {
+        noteNumber = 0,
+        velocity
+    };
+
+    /** The most voices that can play at once. A note past this takes over the quietest voice. */
+    static constexpr int maxVoices = 16;
+
+    VoicePanner() = default;
+
+    /** Allocates the scratch buffers and works out the fade times, call this from prepareToPlay(). */
+    void prepare (double sampleRate, int maximumBlockSize);
+
+    /** Stops every voice. */
+    void reset() noexcept;
+
+    void setRateSource (RateSource newSource) noexcept          { rateSource = newSource; }
+
+    /** How far the phase moves each sample for middle C, or for a velocity of 64. */
+    void setBaseIncrement (double newIncrement) noexcept;
+
+    /** Hands over the MIDI for the next block. process() and advance() pick the notes out of it as they reach them. */
+    void beginBlock (const juce::MidiBuffer& midiMessages) noexcept;
+
+    /** Applies the pan gains to a pair of channels and moves every voice on. Works on floats or doubles. */
+    template <typename SampleType>
+    void process (SampleType* left, SampleType* right, int numSamples) noexcept;
+
+    /** Moves every voice on by numSamples without rendering any gains, for a block that is skipped. */
+    void advance (int numSamples) noexcept;
+
+    int getNumActiveVoices() const noexcept                    { return numActiveVoices; }
+
+private:
+    // Calls renderSegment (offset, length) for each run of samples between the notes, handling each note as it is reached.
+    template <typename SegmentFunction>
+    void forEachSegment (int numSamples, SegmentFunction&& renderSegment) noexcept;
+
+    void handleMessage (const juce::MidiMessage& message) noexcept;
+    void startVoice (int note, int velocity) noexcept;
+    void releaseVoice (int note) noexcept;
+    void removeFinishedVoices() noexcept;
+    float getRatio (int note, int velocity) const noexcept;
+
+    // Sums every voice into the pan position for each sample, the voices across the SIMD lanes.
+    template <typename Ops>
+    void renderPan (float* pan, int numSamples) noexcept;
+
+    // Turns pan positions into left and right gains, the samples across the SIMD lanes.
+    template <typename Ops>
+    int renderGainLanes (const float* pan, float* leftGains, float* rightGains, int numSamples) const noexcept;
+
+    //==============================================================================
+    // One array per value, one lane per voice. Lanes past numActiveVoices are all zeros, so they add nothing.
+    std::array<float, maxVoices> phases {}, increments {}, ratios {}, levels {}, slopes {};
+    std::array<int, maxVoices> notes {};
+    int numActiveVoices = 0;
+
+    RateSource rateSource = RateSource::noteNumber;
+    double baseIncrement = 0.0;
+    float attackSlope = 0.0f, releaseSlope = 0.0f;
+
+    // Row 0 holds the pan, rows 1 and 2 the left and right gains.
+    juce::AudioBuffer<float> scratch;
+
+    // The block's MIDI and how far into the block the voices have got.
+    const juce::MidiBuffer* blockMidi = nullptr;
+    int blockPosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoicePanner)
+};
@@ -0,0 +1,327 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../DistortionAO/Source/DistortionKernels.h"
+#include "ProcessorBenchmarks.h"
+
+namespace
+{
+    // A stereo 512 sample block, the same as a typical host buffer.
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 512;
+    constexpr int numBlocks = 20000;
+
+    constexpr float threshold = 0.5f;
+    constexpr float mix = 0.7f;
+
+    // The names match the items in the DistortionAO editor's combo box.
+    const char* const modeNames[] = { "Hard Clip", "Soft Clip", "Half-Wave Rect" };
+
+    // The curves the original loop had, in the same order.
+    const DistortionKernels::CurveType referenceCurves[] = { DistortionKernels::CurveType::hardClip,
+                                                             DistortionKernels::CurveType::softClip,
+                                                             DistortionKernels::CurveType::halfWaveRectifier };
+
+    //==============================================================================
+    // The original per-sample loop from DistortionAOAudioProcessor::processBlock, kept as the baseline.
+    void processReference (juce::AudioBuffer<float>& buffer, int menuChoice)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* channelData = buffer.getWritePointer(channel);
+
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            {
+                auto input = channelData[sample];
+                auto cleanOut = channelData[sample];
+
+                switch (menuChoice)
+                {
+                case 1:
+                    if (input > threshold)
+                        input = threshold;
+                    else if (input < -threshold)
+                        input = -threshold;
+                    break;
+                case 2:
+                    if (input > threshold)
+                        input = 1.0f - expf(-input);
+                    else if (input < -threshold)
+                        input = -1.0f + expf(input);
+                    break;
+                case 3:
+                    if (! (input > threshold))
+                        input = 0;
+                    break;
+                default:
+                    break;
+                }
+
+                channelData[sample] = ((1 - mix) * cleanOut) + (mix * input);
+            }
+        }
+    }
+
+    // The same thing done the way processBlock does it now, one kernel per channel, on floats or doubles.
+    template <typename SampleType>
+    void processKernels (juce::AudioBuffer<SampleType>& buffer, int menuChoice)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* channelData = buffer.getWritePointer(channel);
+
+            DistortionKernels::process(referenceCurves[menuChoice - 1], channelData, buffer.getNumSamples(), (SampleType) threshold, (SampleType) mix);
+        }
+    }
+
+    // Runs one curve policy straight over every channel, so the table and exact versions of a curve can be compared.
+    template <template <typename> class Curve, typename SampleType>
+    void processCurve (juce::AudioBuffer<SampleType>& buffer)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            DistortionKernels::process<Curve>(buffer.getWritePointer(channel), buffer.getNumSamples(), (SampleType) threshold, (SampleType) mix);
+    }
+
+    //==============================================================================
+    // Runs the process function over numBlocks blocks and returns the average time per block in nanoseconds.
+    // The block is refilled from the source every time, just like a host would, so both sides pay for the copy.
+    template <typename SampleType, typename ProcessFunction>
+    double timeBlocks (const juce::AudioBuffer<SampleType>& source, juce::AudioBuffer<SampleType>& work, int blocks, ProcessFunction&& process)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int i = 0; i < blocks; ++i)
+        {
+            work.makeCopyOf(source, true);
+            process(work);
+        }
+
+        auto end = juce::Time::getHighResolutionTicks();
+
+        return juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e9 / blocks;
+    }
+
+    // Largest difference between two buffers, used to check the kernels still match the original curves.
+    float findMaxDifference (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        float maxDifference = 0.0f;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int sample = 0; sample < a.getNumSamples(); ++sample)
+                maxDifference = juce::jmax(maxDifference, std::abs(a.getSample(channel, sample) - b.getSample(channel, sample)));
+
+        return maxDifference;
+    }
+
+    //==============================================================================
+    // White noise hits the thresholds at random, which is the worst case for the old branches.
+    void fillNoise (juce::AudioBuffer<float>& buffer)
+    {
+        juce::Random random(42);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+                buffer.setSample(channel, sample, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    // A sine wave crosses the thresholds in a pattern the branch predictor can follow.
+    void fillSine (juce::AudioBuffer<float>& buffer)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+                buffer.setSample(channel, sample, 0.9f * std::sin(2.0f * juce::float_Pi * 440.0f * (float) sample / 48000.0f));
+    }
+
+    //==============================================================================
+    // Compares the DistortionAO kernels against the original loop. Returns false if their output has drifted.
+    bool runKernelBenchmarks()
+    {
+        // On an SSE2 build the kernels hand over to the AVX2 copy when the CPU has it, which is what gets timed here.
+        auto usesAvx2 = DistortionKernels::canUseAvx2();
+        auto lanes = usesAvx2 ? 8 : SimdOps::Native::width;
+        auto doubleLanes = usesAvx2 ? 4 : SimdOps::NativeDouble::width;
+
+        std::cout << "DistortionAO kernels, " << numChannels << " channels x " << blockSize << " samples, "
+                  << lanes << " SIMD lanes (" << doubleLanes << " for doubles)"
+                  << (usesAvx2 ? ", AVX2 picked at run time" : "") << std::endl << std::endl;
+
+        std::cout << "signal  mode            reference ns  kernel ns  speedup  max error  double ns" << std::endl;
+
+        juce::AudioBuffer<float> source(numChannels, blockSize), reference(numChannels, blockSize), kernels(numChannels, blockSize);
+        juce::AudioBuffer<double> doubleSource(numChannels, blockSize), doubleKernels(numChannels, blockSize);
+        bool allMatch = true;
+
+        for (auto* signalName : { "noise", "sine" })
+        {
+            if (juce::String(signalName) == "noise")
+                fillNoise(source);
+            else
+                fillSine(source);
+
+            doubleSource.makeCopyOf(source);
+
+            for (int menuChoice = 1; menuChoice <= 3; ++menuChoice)
+            {
+                // Warm up the caches and the branch predictor before timing anything.
+                timeBlocks(source, reference, numBlocks / 10, [=](auto& b) { processReference(b, menuChoice); });
+                timeBlocks(source, kernels, numBlocks / 10, [=](auto& b) { processKernels(b, menuChoice); });
+
+                auto referenceTime = timeBlocks(source, reference, numBlocks, [=](auto& b) { processReference(b, menuChoice); });
+                auto kernelTime = timeBlocks(source, kernels, numBlocks, [=](auto& b) { processKernels(b, menuChoice); });
+
+                // The double kernels have half the lanes, so they are shown next to the float ones rather than the reference.
+                timeBlocks(doubleSource, doubleKernels, numBlocks / 10, [=](auto& b) { processKernels(b, menuChoice); });
+                auto doubleTime = timeBlocks(doubleSource, doubleKernels, numBlocks, [=](auto& b) { processKernels(b, menuChoice); });
+
+                // Both buffers hold the output of the last block, so they can be compared directly.
+                auto maxDifference = findMaxDifference(reference, kernels);
+                allMatch = allMatch && maxDifference < 1.0e-6f;
+
+                std::cout << juce::String(signalName).paddedRight(' ', 8)
+                          << juce::String(modeNames[menuChoice - 1]).paddedRight(' ', 16)
+                          << juce::String(referenceTime, 1).paddedLeft(' ', 12)
+                          << juce::String(kernelTime, 1).paddedLeft(' ', 11)
+                          << juce::String(referenceTime / kernelTime, 2).paddedLeft(' ', 8) << "x"
+                          << juce::String(maxDifference).paddedLeft(' ', 11)
+                          << juce::String(doubleTime, 1).paddedLeft(' ', 11) << std::endl;
+            }
+        }
+
+        if (! allMatch)
+            std::cout << std::endl << "The kernels no longer match the original curves!" << std::endl;
+
+        return allMatch;
+    }
+
+    //==============================================================================
+    // Times the curves that have no original loop to compare with. Tanh and Arctan are also run with std::tanh and
+    // std::atan in place of their tables, to show what the tables save and check they are still accurate.
+    bool runWaveshaperBenchmarks()
+    {
+        using namespace DistortionKernels;
+
+        std::cout << "curve           kernel ns  double ns  exact ns  table error" << std::endl;
+
+        juce::AudioBuffer<float> source(numChannels, blockSize), table(numChannels, blockSize), exact(numChannels, blockSize);
+        juce::AudioBuffer<double> doubleSource(numChannels, blockSize), doubleWork(numChannels, blockSize);
+        bool allMatch = true;
+
+        fillNoise(source);
+        doubleSource.makeCopyOf(source);
+
+        auto report = [&](const char* name, auto&& process, auto&& processExact)
+        {
+            timeBlocks(source, table, numBlocks / 10, process);
+            auto kernelTime = timeBlocks(source, table, numBlocks, process);
+
+            timeBlocks(doubleSource, doubleWork, numBlocks / 10, process);
+            auto doubleTime = timeBlocks(doubleSource, doubleWork, numBlocks, process);
+
+            std::cout << juce::String(name).paddedRight(' ', 16)
+                      << juce::String(kernelTime, 1).paddedLeft(' ', 9)
+                      << juce::String(doubleTime, 1).paddedLeft(' ', 11);
+
+            if constexpr (! std::is_same_v<std::decay_t<decltype(processExact)>, std::nullptr_t>)
+            {
+                auto exactTime = timeBlocks(source, exact, numBlocks, processExact);
+                auto maxDifference = findMaxDifference(table, exact);
+                allMatch = allMatch && maxDifference < 1.0e-5f;
+
+                std::cout << juce::String(exactTime, 1).paddedLeft(' ', 10)
+                          << juce::String(maxDifference).paddedLeft(' ', 13);
+            }
+
+            std::cout << std::endl;
+        };
+
+        report("Tanh", [](auto& b) { processCurve<Tanh>(b); }, [](auto& b) { processCurve<TanhExact>(b); });
+        report("Arctan", [](auto& b) { processCurve<Arctan>(b); }, [](auto& b) { processCurve<ArctanExact>(b); });
+        report("Cubic", [](auto& b) { processCurve<Cubic>(b); }, nullptr);
+        report("Asymmetric", [](auto& b) { processCurve<Asymmetric>(b); }, nullptr);
+
+        if (! allMatch)
+            std::cout << std::endl << "The curve tables have drifted from std::tanh and std::atan!" << std::endl;
+
+        return allMatch;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help"))
+    {
+        std::cout << "Usage: Benchmarks [--kernels | --processors] [--plugin <name>] [--quick] [--double] [--json <file>]" << std::endl;
+        return 0;
+    }
+
+    // Some of the processors post messages, so they need a message manager even without a window.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    // Both halves run unless one of them is asked for.
+    auto runKernels = ! args.containsOption("--processors");
+    auto runProcessors = ! args.containsOption("--kernels");
+    auto kernelsMatch = true;
+
+    if (runKernels)
+    {
+        kernelsMatch = runKernelBenchmarks();
+        std::cout << std::endl;
+        kernelsMatch = runWaveshaperBenchmarks() && kernelsMatch;
+    }
+
+    if (runProcessors)
+    {
+        ProcessorBenchmarks::Options options;
+        options.plugin = args.getValueForOption("--plugin");
+        options.quick = args.containsOption("--quick");
+        options.doublePrecision = args.containsOption("--double");
+
+        if (runKernels)
+            std::cout << std::endl;
+
+        auto results = ProcessorBenchmarks::run(options);
+
+        // The decay runs are short, and show whether quiet tails still cost what loud signals do.
+        auto decayResults = ProcessorBenchmarks::runDecay(options);
+        results.insert(results.end(), decayResults.begin(), decayResults.end());
+
+        // The chain is timed against the same three processors run as separate plugins.
+        if (options.plugin.isEmpty() || options.plugin.equalsIgnoreCase("Chain"))
+        {
+            auto chainResults = ProcessorBenchmarks::runChain(options);
+            results.insert(results.end(), chainResults.begin(), chainResults.end());
+        }
+
+        // The graph shows how many instances this machine can run, and how well that scales with threads.
+        if (options.plugin.isEmpty() || options.plugin.equalsIgnoreCase("Graph"))
+        {
+            auto graphResults = ProcessorBenchmarks::runGraph(options);
+            results.insert(results.end(), graphResults.begin(), graphResults.end());
+        }
+
+        // The JSON is meant to be kept from one commit to the next and diffed.
+        if (args.containsOption("--json"))
+        {
+            auto jsonFile = args.getFileForOption("--json");
+
+            if (! jsonFile.replaceWithText(juce::JSON::toString(ProcessorBenchmarks::toJson(results))))
+            {
+                std::cerr << "Couldn't write " << jsonFile.getFullPathName() << std::endl;
+                return 1;
+            }
+
+            std::cout << std::endl << "Results written to " << jsonFile.getFullPathName() << std::endl;
+        }
+    }
+
+    return kernelsMatch ? 0 : 1;
+}
@@ -0,0 +1,671 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmarks.cpp
+    Created: 17 Oct 2026 4:48:30pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "ProcessorBenchmarks.h"
+#include "../../Shared/PluginRegistry.h"
+#include "../../Shared/ChainHost.h"
+#include "../../Shared/GraphScheduler.h"
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+namespace ProcessorBenchmarks
+{
+    namespace
+    {
+        // A parameter setting worth timing on its own, such as one of DistortionAO's modes.
+        struct Setting
+        {
+            juce::String name;
+            std::vector<std::pair<juce::String, float>> parameters;
+
+            // Notes sent before the timing starts and never released, for the Autopanner's MIDI voices.
+            int numHeldNotes = 0;
+        };
+
+        // Everything that is swept for one plugin.
+        struct PluginSweep
+        {
+            juce::String plugin;
+            std::vector<int> channelCounts;
+            std::vector<Setting> settings;
+        };
+
+        // A choice parameter's menu, read from a fresh instance of the plugin so the sweep always covers every item.
+        juce::StringArray getChoices(const juce::String& pluginName, const juce::String& parameterID)
+        {
+            if (auto processor = PluginRegistry::createPlugin(pluginName))
+                for (auto* parameter : processor->getParameters())
+                    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(parameter))
+                        if (choice->getParameterID() == parameterID)
+                            return choice->choices;
+
+            return {};
+        }
+
+        std::vector<PluginSweep> getSweeps()
+        {
+            PluginSweep demoProject{ "DemoProject", { 1, 2 }, { { "Gain 0.5", { { "GAIN", 0.5f } } } } };
+
+            // Mono, stereo, 5.1 and 7.1, so the surround panner is timed next to the stereo pan law.
+            PluginSweep autopanner{ "Autopanner", { 1, 2, 6, 8 }, {} };
+
+            for (auto ms : { 10.0f, 250.0f, 5000.0f })
+                autopanner.settings.push_back({ juce::String(ms, 0) + " ms", { { "MS", ms } } });
+
+            // There is no play head here, so this times the tempo sync path running free at 120 bpm.
+            autopanner.settings.push_back({ "Sync 1/8", { { "SYNC", 1.0f }, { "DIVISION", 5.0f } } });
+
+            // Stereo ignores the surround pan mode, but it is the focused one that changes the cost for 5.1 and 7.1.
+            autopanner.settings.push_back({ "250 ms VBAP", { { "MS", 250.0f }, { "PANMODE", 1.0f } } });
+
+            // One voice against the single LFO above, and every voice at once. Only stereo uses them.
+            autopanner.settings.push_back({ "250 ms MIDI 1 voice", { { "MS", 250.0f }, { "MIDIMODE", 1.0f } }, 1 });
+            autopanner.settings.push_back({ "250 ms MIDI 16 voices", { { "MS", 250.0f }, { "MIDIMODE", 1.0f } }, 16 });
+
+            // The same threshold and mix as the kernel benchmark, so the two can be compared.
+            PluginSweep distortion{ "DistortionAO", { 1, 2 }, {} };
+
+            // MODE is a choice parameter, so it takes the index of the mode rather than its menu ID.
+            // The names come from the menu itself, so a new curve is timed as soon as it is added.
+            const auto modeNames = getChoices("DistortionAO", "MODE");
+
+            for (int modeIndex = 0; modeIndex < modeNames.size(); ++modeIndex)
+                distortion.settings.push_back({ modeNames[modeIndex], { { "MODE", (float) modeIndex }, { "THRESHOLD", 0.5f }, { "MIX", 0.7f } } });
+
+            // Oversampling costs the same whatever the curve, so one curve is enough to see it.
+            for (int factor = 1; factor <= 3; ++factor)
+                for (int filter = 0; filter < 2; ++filter)
+                    distortion.settings.push_back({ juce::String("Soft Clip ") + juce::String(1 << factor) + (filter == 0 ? "x IIR" : "x Linear Phase"),
+                                                    { { "MODE", 1.0f }, { "THRESHOLD", 0.5f }, { "MIX", 0.7f },
+                                                      { "OVERSAMPLING", (float) factor }, { "OSFILTER", (float) filter } } });
+
+            // The stereo modes against the dual mono Soft Clip above. A mono layout always runs dual mono, so these are only worth timing in stereo.
+            distortion.settings.push_back({ "Soft Clip Linked", { { "MODE", 1.0f }, { "THRESHOLD", 0.5f }, { "MIX", 0.7f }, { "STEREO", 1.0f } } });
+            distortion.settings.push_back({ "Soft Clip Mid/Side", { { "MODE", 1.0f }, { "THRESHOLD", 0.5f }, { "MIX", 0.7f }, { "STEREO", 2.0f },
+                                                                    { "SIDETHRESHOLD", 0.3f }, { "SIDEMIX", 0.9f } } });
+
+            return { demoProject, autopanner, distortion };
+        }
+
+        //==============================================================================
+        // Cycles are read straight from the time stamp counter where there is one. Anywhere else
+        // they are worked out from the elapsed time and the CPU's advertised clock speed.
+        juce::int64 readCycleCounter() noexcept
+        {
+           #if JUCE_INTEL
+            return (juce::int64) __rdtsc();
+           #else
+            return 0;
+           #endif
+        }
+
+        struct Timing
+        {
+            double seconds = 0.0;
+            double cycles = 0.0;
+        };
+
+        // White noise loud enough to cross every threshold, long enough that each block sees different samples.
+        template <typename SampleType>
+        juce::AudioBuffer<SampleType> makeSource(int numChannels)
+        {
+            juce::AudioBuffer<SampleType> source(numChannels, 1 << 14);
+            juce::Random random(42);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int sample = 0; sample < source.getNumSamples(); ++sample)
+                    source.setSample(channel, sample, (SampleType) ((random.nextFloat() * 2.0f - 1.0f) * 0.9f));
+
+            return source;
+        }
+
+        // Feeds numBlocks blocks from the source through the processor, or just copies them if there is no processor.
+        // The copy is timed on its own and taken off, so the result is the cost of processBlock alone.
+        template <typename SampleType>
+        Timing timeBlocks(juce::AudioProcessor* processor, const juce::AudioBuffer<SampleType>& source,
+                          juce::AudioBuffer<SampleType>& block, int numBlocks)
+        {
+            juce::MidiBuffer midiMessages;
+            const auto blockSize = block.getNumSamples();
+            const auto numOffsets = source.getNumSamples() / blockSize;
+
+            auto startCycles = readCycleCounter();
+            auto startTicks = juce::Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                auto offset = (i % juce::jmax(1, numOffsets)) * blockSize;
+
+                for (int channel = 0; channel < block.getNumChannels(); ++channel)
+                    block.copyFrom(channel, 0, source, channel, juce::jmin(offset, source.getNumSamples() - blockSize), blockSize);
+
+                if (processor != nullptr)
+                    processor->processBlock(block, midiMessages);
+            }
+
+            auto endTicks = juce::Time::getHighResolutionTicks();
+            auto endCycles = readCycleCounter();
+
+            Timing timing;
+            timing.seconds = juce::Time::highResolutionTicksToSeconds(endTicks - startTicks);
+            timing.cycles = (double) (endCycles - startCycles);
+
+            if (timing.cycles <= 0.0)
+                timing.cycles = timing.seconds * juce::SystemStats::getCpuSpeedInMegahertz() * 1.0e6;
+
+            return timing;
+        }
+
+        // The same noise as makeSource(), scaled down to a level.
+        template <typename SampleType>
+        juce::AudioBuffer<SampleType> makeScaledSource(int numChannels, SampleType level)
+        {
+            auto source = makeSource<SampleType>(numChannels);
+            source.applyGain(level);
+            return source;
+        }
+
+        // The median is used rather than the mean so one preempted run doesn't show up as a regression.
+        double median(std::vector<double> values)
+        {
+            std::sort(values.begin(), values.end());
+            return values[values.size() / 2];
+        }
+
+        template <typename SampleType>
+        Result measure(const PluginSweep& sweep, const Setting& setting, int blockSize, double sampleRate,
+                       int numChannels, const juce::AudioBuffer<SampleType>& source, int samplesPerRun)
+        {
+            constexpr int numRuns = 5;
+            constexpr bool isDouble = std::is_same_v<SampleType, double>;
+
+            Result result{ sweep.plugin, setting.name, blockSize, sampleRate, numChannels, isDouble };
+
+            auto processor = PluginRegistry::createPlugin(sweep.plugin);
+
+            if (processor == nullptr || ! PluginRegistry::setChannelLayout(*processor, numChannels))
+                return result;
+
+            // A processor without a double path would have the host convert every block, which isn't what is being timed here.
+            if (isDouble && ! processor->supportsDoublePrecisionProcessing())
+                return result;
+
+            processor->setProcessingPrecision(isDouble ? juce::AudioProcessor::doublePrecision
+                                                       : juce::AudioProcessor::singlePrecision);
+
+            for (auto& [parameterID, value] : setting.parameters)
+                PluginRegistry::setParameter(*processor, parameterID, value);
+
+            processor->setNonRealtime(true);
+            processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor->prepareToPlay(sampleRate, blockSize);
+
+            juce::AudioBuffer<SampleType> block(numChannels, blockSize);
+
+            if (setting.numHeldNotes > 0)
+            {
+                juce::MidiBuffer noteOns;
+
+                for (int note = 0; note < setting.numHeldNotes; ++note)
+                    noteOns.addEvent(juce::MidiMessage::noteOn(1, 48 + note, (juce::uint8) 100), 0);
+
+                block.clear();
+                processor->processBlock(block, noteOns);
+            }
+
+            auto numBlocks = juce::jmax(1, samplesPerRun / blockSize);
+            auto numSamples = (double) numBlocks * blockSize;
+
+            // One untimed run gets the caches, the branch predictor and the processor's state warmed up.
+            timeBlocks(processor.get(), source, block, numBlocks);
+
+            std::vector<double> nanoseconds, cycles;
+
+            for (int run = 0; run < numRuns; ++run)
+            {
+                auto copyOnly = timeBlocks(nullptr, source, block, numBlocks);
+                auto processed = timeBlocks(processor.get(), source, block, numBlocks);
+
+                nanoseconds.push_back(juce::jmax(0.0, processed.seconds - copyOnly.seconds) * 1.0e9 / numSamples);
+                cycles.push_back(juce::jmax(0.0, processed.cycles - copyOnly.cycles) / numSamples);
+            }
+
+            processor->releaseResources();
+
+            result.nanosecondsPerSample = median(nanoseconds);
+            result.cyclesPerSample = median(cycles);
+
+            return result;
+        }
+
+        //==============================================================================
+        // One setting per plugin, whichever does the most arithmetic on each sample.
+        std::vector<std::pair<PluginSweep, Setting>> getDecaySettings()
+        {
+            return { { { "DemoProject", { 2 }, {} }, { "Gain 0.5", { { "GAIN", 0.5f } } } },
+                     { { "Autopanner", { 2 }, {} }, { "250 ms", { { "MS", 250.0f } } } },
+                     { { "Autopanner", { 6 }, {} }, { "250 ms 5.1 VBAP", { { "MS", 250.0f }, { "PANMODE", 1.0f } } } },
+                     { { "DistortionAO", { 2 }, {} }, { "Soft Clip", { { "MODE", 1.0f }, { "THRESHOLD", 0.5f }, { "MIX", 0.7f } } } },
+                     { { "DistortionAO", { 2 }, {} }, { "Soft Clip ADAA2", { { "MODE", 6.0f }, { "THRESHOLD", 0.5f }, { "MIX", 0.7f } } } },
+                     { { "DistortionAO", { 2 }, {} }, { "Soft Clip 4x IIR", { { "MODE", 1.0f }, { "THRESHOLD", 0.5f }, { "MIX", 0.7f },
+                                                                              { "OVERSAMPLING", 2.0f }, { "OSFILTER", 0.0f } } } } };
+        }
+
+        template <typename SampleType>
+        std::vector<Result> measureDecay(const Options& options)
+        {
+            // The levels are set against the smallest normal number, so the same steps land in the denormals for floats and doubles.
+            const auto smallestNormal = std::numeric_limits<SampleType>::min();
+
+            const std::vector<std::pair<juce::String, SampleType>> levels { { "0 dB", (SampleType) 0.9 },
+                                                                             { "-100 dB", (SampleType) 1.0e-5 },
+                                                                             { "normal x 1e4", smallestNormal * (SampleType) 1.0e4 },
+                                                                             { "denormal", smallestNormal * (SampleType) 0.5 },
+                                                                             { "deep denormal", smallestNormal * (SampleType) 1.0e-4 },
+                                                                             { "silence", (SampleType) 0 } };
+
+            const auto blockSize = 512;
+            const auto sampleRate = 48000.0;
+            const auto samplesPerRun = options.quick ? (1 << 14) : (1 << 17);
+
+            std::cout << std::endl << "Decaying input, " << (options.doublePrecision ? "double" : "single") << " precision, "
+                      << blockSize << " samples at " << (int) sampleRate << " Hz" << std::endl << std::endl;
+            std::cout << "plugin        setting            level           ns/sample  x 0 dB" << std::endl;
+
+            std::vector<Result> results;
+            auto flat = true;
+
+            for (auto& [sweep, setting] : getDecaySettings())
+            {
+                if (options.plugin.isNotEmpty() && ! options.plugin.equalsIgnoreCase(sweep.plugin))
+                    continue;
+
+                double loudCost = 0.0;
+
+                for (auto& [levelName, level] : levels)
+                {
+                    const auto numChannels = sweep.channelCounts.front();
+                    auto source = makeScaledSource(numChannels, level);
+
+                    auto result = measure(sweep, setting, blockSize, sampleRate, numChannels, source, samplesPerRun);
+                    result.mode = setting.name + " @ " + levelName;
+
+                    if (loudCost <= 0.0)
+                        loudCost = result.nanosecondsPerSample;
+
+                    // Timing is noisy, but denormals cost ten times more or worse, well clear of it.
+                    auto ratio = loudCost > 0.0 ? result.nanosecondsPerSample / loudCost : 0.0;
+                    flat = flat && ratio < 2.0;
+
+                    std::cout << sweep.plugin.paddedRight(' ', 14)
+                              << setting.name.paddedRight(' ', 19)
+                              << levelName.paddedRight(' ', 14)
+                              << juce::String(result.nanosecondsPerSample, 2).paddedLeft(' ', 11)
+                              << juce::String(ratio, 2).paddedLeft(' ', 8) << std::endl;
+
+                    results.push_back(result);
+                }
+            }
+
+            if (! flat)
+                std::cout << std::endl << "Some quiet levels cost more than twice as much as the loud one, check for denormals!" << std::endl;
+
+            return results;
+        }
+
+        //==============================================================================
+        // The settings each stage of the chain is timed with, the same ones the sweep uses.
+        void setUpStage(juce::AudioProcessor& processor, int stage)
+        {
+            const std::vector<std::pair<juce::String, float>> settings[] = { { { "GAIN", 0.5f } },
+                                                                              { { "MODE", 1.0f }, { "THRESHOLD", 0.5f }, { "MIX", 0.7f } },
+                                                                              { { "MS", 250.0f } } };
+
+            if (juce::isPositiveAndBelow(stage, (int) std::size(settings)))
+                for (auto& [parameterID, value] : settings[stage])
+                    PluginRegistry::setParameter(processor, parameterID, value);
+        }
+
+        void setUpChain(ChainHost& chain)
+        {
+            for (int i = 0; i < chain.getNumProcessors(); ++i)
+                setUpStage(chain.getProcessor(i), i);
+        }
+
+        // Runs the function over numBlocks blocks and returns the seconds it took. The function gets the offset into the source.
+        template <typename BlockFunction>
+        double timeChainBlocks(int numBlocks, int numOffsets, int blockSize, BlockFunction&& processOneBlock)
+        {
+            auto startTicks = juce::Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numBlocks; ++i)
+                processOneBlock((i % juce::jmax(1, numOffsets)) * blockSize);
+
+            return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        }
+
+        template <typename SampleType>
+        std::vector<Result> measureChain(const Options& options)
+        {
+            constexpr int numRuns = 5;
+            constexpr int numChannels = 2;
+            constexpr double sampleRate = 48000.0;
+            constexpr bool isDouble = std::is_same_v<SampleType, double>;
+
+            const std::vector<int> blockSizes = options.quick ? std::vector<int>{ 64, 512 } : std::vector<int>{ 32, 64, 128, 256, 512, 1024, 2048 };
+            const auto samplesPerRun = options.quick ? (1 << 14) : (1 << 17);
+            auto source = makeSource<SampleType>(numChannels);
+
+            std::cout << std::endl << "Gain -> distortion -> autopan, " << (isDouble ? "double" : "single") << " precision, stereo at "
+                      << (int) sampleRate << " Hz" << std::endl << std::endl;
+            std::cout << "block  three hops ns/sample  chain ns/sample  saved" << std::endl;
+
+            std::vector<Result> results;
+
+            for (auto blockSize : blockSizes)
+            {
+                // Two copies of the same chain, one run as separate plugins and one in place.
+                ChainHost hops, chain;
+
+                for (auto* host : { &hops, &chain })
+                {
+                    setUpChain(*host);
+
+                    if (! host->setChannelLayout(numChannels) || ! host->setDoublePrecision(isDouble))
+                        return results;
+
+                    host->prepare(sampleRate, blockSize, true);
+                }
+
+                const auto numBlocks = juce::jmax(1, samplesPerRun / blockSize);
+                const auto numOffsets = source.getNumSamples() / blockSize;
+                const auto numSamples = (double) numBlocks * blockSize;
+
+                // What a host does: each plugin has its own buffer, the audio is copied into it, processed and copied on to the next.
+                std::vector<juce::AudioBuffer<SampleType>> hopBuffers;
+
+                for (int i = 0; i <= hops.getNumProcessors(); ++i)
+                    hopBuffers.emplace_back(numChannels, blockSize);
+
+                juce::AudioBuffer<SampleType> chainBuffer(numChannels, blockSize);
+                juce::MidiBuffer midiMessages;
+
+                auto runHops = [&](int offset)
+                {
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        hopBuffers[0].copyFrom(channel, 0, source, channel, offset, blockSize);
+
+                    for (int i = 0; i < hops.getNumProcessors(); ++i)
+                    {
+                        hops.getProcessor(i).processBlock(hopBuffers[(size_t) i], midiMessages);
+                        hopBuffers[(size_t) i + 1].makeCopyOf(hopBuffers[(size_t) i], true);
+                    }
+                };
+
+                auto runInPlace = [&](int offset)
+                {
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        chainBuffer.copyFrom(channel, 0, source, channel, offset, blockSize);
+
+                    chain.process(chainBuffer, midiMessages);
+                };
+
+                // One untimed run of each warms up the caches and the processors.
+                timeChainBlocks(numBlocks, numOffsets, blockSize, runHops);
+                timeChainBlocks(numBlocks, numOffsets, blockSize, runInPlace);
+
+                std::vector<double> hopTimes, chainTimes;
+
+                for (int run = 0; run < numRuns; ++run)
+                {
+                    hopTimes.push_back(timeChainBlocks(numBlocks, numOffsets, blockSize, runHops) * 1.0e9 / numSamples);
+                    chainTimes.push_back(timeChainBlocks(numBlocks, numOffsets, blockSize, runInPlace) * 1.0e9 / numSamples);
+                }
+
+                Result hopResult{ "Chain", "Three hops", blockSize, sampleRate, numChannels, isDouble, median(hopTimes), 0.0 };
+                Result chainResult{ "Chain", "In place", blockSize, sampleRate, numChannels, isDouble, median(chainTimes), 0.0 };
+
+                std::cout << juce::String(blockSize).paddedLeft(' ', 5)
+                          << juce::String(hopResult.nanosecondsPerSample, 2).paddedLeft(' ', 23)
+                          << juce::String(chainResult.nanosecondsPerSample, 2).paddedLeft(' ', 17)
+                          << (juce::String(100.0 * (1.0 - chainResult.nanosecondsPerSample / juce::jmax(hopResult.nanosecondsPerSample, 1.0e-9)), 1) + "%").paddedLeft(' ', 7)
+                          << std::endl;
+
+                results.push_back(hopResult);
+                results.push_back(chainResult);
+            }
+
+            return results;
+        }
+
+        //==============================================================================
+        // A graph a big session might have: one input gain fanned out to many chains of
+        // gain -> distortion -> autopan, all summed back into one master gain.
+        void buildGraph(GraphScheduler& graph, int numBranches)
+        {
+            const auto chain = ChainHost::getDefaultChain();
+            auto input = graph.addNode(PluginRegistry::createPlugin("DemoProject"));
+            auto master = graph.addNode(PluginRegistry::createPlugin("DemoProject"));
+
+            for (int branch = 0; branch < numBranches; ++branch)
+            {
+                auto previous = input;
+
+                for (int stage = 0; stage < chain.size(); ++stage)
+                {
+                    auto node = graph.addNode(PluginRegistry::createPlugin(chain[stage]));
+                    setUpStage(graph.getProcessor(node), stage);
+                    graph.connect(previous, node);
+                    previous = node;
+                }
+
+                graph.connect(previous, master);
+            }
+        }
+
+        // Prints the average and worst cost of each kind of processor, and the single slowest node.
+        void printNodeTimings(const GraphScheduler& graph)
+        {
+            struct Totals { double total = 0.0, worst = 0.0; int count = 0; };
+            std::map<juce::String, Totals> byPlugin;
+            GraphScheduler::NodeTiming slowest;
+
+            for (auto& timing : graph.getNodeTimings())
+            {
+                auto& totals = byPlugin[timing.name.upToLastOccurrenceOf(" ", false, false)];
+                totals.total += timing.averageMicroseconds;
+                totals.worst = juce::jmax(totals.worst, timing.maxMicroseconds);
+                ++totals.count;
+
+                if (timing.maxMicroseconds > slowest.maxMicroseconds)
+                    slowest = timing;
+            }
+
+            for (auto& [plugin, totals] : byPlugin)
+                std::cout << "    " << plugin.paddedRight(' ', 14) << juce::String(totals.count).paddedLeft(' ', 4) << " nodes, "
+                          << juce::String(totals.total / juce::jmax(1, totals.count), 2) << " us average, "
+                          << juce::String(totals.worst, 2) << " us worst" << std::endl;
+
+            std::cout << "    slowest node  " << slowest.name << ", " << juce::String(slowest.maxMicroseconds, 2) << " us" << std::endl;
+        }
+    }
+
+    //==============================================================================
+    std::vector<Result> run(const Options& options)
+    {
+        const std::vector<int> blockSizes = options.quick ? std::vector<int>{ 64, 512, 4096 }
+                                                          : std::vector<int>{ 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+        const std::vector<double> sampleRates = options.quick ? std::vector<double>{ 48000.0 }
+                                                              : std::vector<double>{ 44100.0, 48000.0, 96000.0, 192000.0 };
+        const auto samplesPerRun = options.quick ? (1 << 14) : (1 << 17);
+
+        std::cout << (options.doublePrecision ? "Double precision" : "Single precision") << std::endl << std::endl;
+        std::cout << "plugin        setting                  block    rate  ch  ns/sample  cycles/sample" << std::endl;
+
+        std::vector<Result> results;
+
+        for (auto& sweep : getSweeps())
+        {
+            if (options.plugin.isNotEmpty() && ! options.plugin.equalsIgnoreCase(sweep.plugin))
+                continue;
+
+            for (auto numChannels : sweep.channelCounts)
+            {
+                auto floatSource = makeSource<float>(numChannels);
+                auto doubleSource = makeSource<double>(numChannels);
+
+                for (auto& setting : sweep.settings)
+                {
+                    for (auto sampleRate : sampleRates)
+                    {
+                        for (auto blockSize : blockSizes)
+                        {
+                            auto result = options.doublePrecision
+                                              ? measure(sweep, setting, blockSize, sampleRate, numChannels, doubleSource, samplesPerRun)
+                                              : measure(sweep, setting, blockSize, sampleRate, numChannels, floatSource, samplesPerRun);
+
+                            std::cout << result.plugin.paddedRight(' ', 14)
+                                      << result.mode.paddedRight(' ', 23)
+                                      << juce::String(result.blockSize).paddedLeft(' ', 6)
+                                      << juce::String((int) result.sampleRate).paddedLeft(' ', 8)
+                                      << juce::String(result.numChannels).paddedLeft(' ', 4)
+                                      << juce::String(result.nanosecondsPerSample, 2).paddedLeft(' ', 11)
+                                      << juce::String(result.cyclesPerSample, 2).paddedLeft(' ', 15) << std::endl;
+
+                            results.push_back(result);
+                        }
+                    }
+                }
+            }
+        }
+
+        return results;
+    }
+
+    std::vector<Result> runChain(const Options& options)
+    {
+        return options.doublePrecision ? measureChain<double>(options) : measureChain<float>(options);
+    }
+
+    std::vector<Result> runGraph(const Options& options)
+    {
+        constexpr int numChannels = 2;
+        constexpr int blockSize = 256;
+        constexpr double sampleRate = 48000.0;
+
+        const auto numBranches = options.quick ? 32 : 100;
+        const auto numCycles = options.quick ? 200 : 2000;
+
+        // One thread, then doubling up to every core.
+        std::vector<int> threadCounts;
+
+        for (int numThreads = 1; numThreads < juce::SystemStats::getNumCpus(); numThreads *= 2)
+            threadCounts.push_back(numThreads);
+
+        threadCounts.push_back(juce::SystemStats::getNumCpus());
+
+        auto source = makeSource<float>(numChannels);
+        const auto numOffsets = source.getNumSamples() / blockSize;
+        juce::AudioBuffer<float> input(numChannels, blockSize), output(numChannels, blockSize);
+
+        std::cout << std::endl << "Graph of " << numBranches << " gain -> distortion -> autopan branches, single precision, stereo at "
+                  << (int) sampleRate << " Hz, " << blockSize << " sample blocks" << std::endl << std::endl;
+
+        if (options.doublePrecision)
+            std::cout << "The graph only runs on floats, so --double doesn't apply to it." << std::endl << std::endl;
+
+        std::vector<Result> results;
+
+        for (auto numThreads : threadCounts)
+        {
+            GraphScheduler graph(numThreads);
+            buildGraph(graph, numBranches);
+
+            if (! graph.prepare(sampleRate, blockSize, numChannels))
+                return results;
+
+            auto runCycles = [&](int count)
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        input.copyFrom(channel, 0, source, channel, (i % juce::jmax(1, numOffsets)) * blockSize, blockSize);
+
+                    graph.process(input, output);
+                }
+            };
+
+            // The first cycles warm up the caches and wake the workers, so they aren't counted.
+            runCycles(juce::jmax(10, numCycles / 10));
+            graph.resetTimings();
+            runCycles(numCycles);
+
+            auto cycle = graph.getCycleTiming();
+
+            std::cout << juce::String(numThreads).paddedLeft(' ', 3) << " threads, " << graph.getNumNodes() << " nodes in "
+                      << graph.getNumTasks() << " tasks: " << juce::String(cycle.averageMicroseconds, 1) << " us a cycle, "
+                      << juce::String(cycle.maxMicroseconds, 1) << " us worst, " << juce::String(100.0 * cycle.averageLoad, 1)
+                      << "% of the block, " << juce::String(100.0 * cycle.maxLoad, 1) << "% worst" << std::endl;
+
+            printNodeTimings(graph);
+
+            results.push_back({ "Graph", juce::String(numThreads) + " threads", blockSize, sampleRate, numChannels, false,
+                                cycle.averageMicroseconds * 1000.0 / blockSize, 0.0 });
+        }
+
+        return results;
+    }
+
+    std::vector<Result> runDecay(const Options& options)
+    {
+        return options.doublePrecision ? measureDecay<double>(options) : measureDecay<float>(options);
+    }
+
+    juce::var toJson(const std::vector<Result>& results)
+    {
+        juce::Array<juce::var> entries;
+
+        for (auto& result : results)
+        {
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("plugin", result.plugin);
+            entry->setProperty("mode", result.mode);
+            entry->setProperty("blockSize", result.blockSize);
+            entry->setProperty("sampleRate", result.sampleRate);
+            entry->setProperty("channels", result.numChannels);
+            entry->setProperty("precision", result.doublePrecision ? "double" : "float");
+            entry->setProperty("nsPerSample", result.nanosecondsPerSample);
+            entry->setProperty("cyclesPerSample", result.cyclesPerSample);
+            entries.add(juce::var(entry));
+        }
+
+        auto* machine = new juce::DynamicObject();
+        machine->setProperty("cpu", juce::SystemStats::getCpuModel());
+        machine->setProperty("mhz", juce::SystemStats::getCpuSpeedInMegahertz());
+        machine->setProperty("os", juce::SystemStats::getOperatingSystemName());
+       #if JUCE_INTEL
+        machine->setProperty("cycleCounter", "tsc");
+       #else
+        machine->setProperty("cycleCounter", "estimated from mhz");
+       #endif
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("machine", juce::var(machine));
+        root->setProperty("results", entries);
+
+        return juce::var(root);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmarks.h
+    Created: 17 Oct 2026 4:48:30pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Times processBlock on every tutorial processor across a sweep of block sizes,
+    sample rates, channel counts and parameter settings.
+
+    Each run reports the cost per sample in nanoseconds and in CPU cycles, and the
+    whole sweep can be written out as JSON so two commits can be diffed.
+*/
+namespace ProcessorBenchmarks
+{
+    /** One processor, one setting, one block size, one sample rate and one layout. */
+    struct Result
+    {
+        juce::String plugin;
+        juce::String mode;
+        int blockSize = 0;
+        double sampleRate = 0.0;
+        int numChannels = 0;
+        bool doublePrecision = false;
+
+        double nanosecondsPerSample = 0.0;
+        double cyclesPerSample = 0.0;
+    };
+
+    /** How much of the sweep to run. */
+    struct Options
+    {
+        // Only run the plugin with this name, or every plugin if it is empty.
+        juce::String plugin;
+
+        // A shorter sweep with fewer samples per run, for a quick look rather than a comparison.
+        bool quick = false;
+
+        // Runs the processors on doubles instead of floats, as a 64 bit host would.
+        bool doublePrecision = false;
+    };
+
+    /** Runs the sweep, printing a table as it goes. */
+    std::vector<Result> run (const Options& options);
+
+    /** Times each processor on noise that fades from full scale, past the smallest normal
+        float, down to silence, one level at a time. Denormals would show up as a level that
+        costs many times more than the loud one, so each level is printed next to that ratio.
+    */
+    std::vector<Result> runDecay (const Options& options);
+
+    /** Times gain, distortion and autopan run the way a host runs three plugins, each with its
+        own buffers and a copy in and out of every one, against the same three in a ChainHost
+        working on one buffer in place.
+    */
+    std::vector<Result> runChain (const Options& options);
+
+    /** Runs a graph of a few hundred processors on a GraphScheduler with one thread, then more
+        up to one per core, printing what each cycle costs and what each kind of node costs.
+    */
+    std::vector<Result> runGraph (const Options& options);
+
+    /** Puts the results into a JSON object along with details about the machine. */
+    juce::var toJson (const std::vector<Result>& results);
+}
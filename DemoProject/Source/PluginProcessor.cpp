@@ -8,6 +8,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "../../Shared/ProfiledGenericEditor.h"
 
 //==============================================================================
 DemoProjectAudioProcessor::DemoProjectAudioProcessor()
@@ -23,6 +24,14 @@ DemoProjectAudioProcessor::DemoProjectAudioProcessor()
 #endif
 {
     addParameter(gain = new juce::AudioParameterFloat("GAIN", "Gain", 0.0f, 1.0f, 0.0f));
+
+    // Built once every parameter exists, the values are worked out by parameter ID.
+    presets.setPresets({ { "Silent", { { "GAIN", 0.0f } } },
+                         { "Half", { { "GAIN", 0.5f } } },
+                         { "Full", { { "GAIN", 1.0f } } } });
+
+    // The first general purpose controller moves the gain.
+    splitter.setMappings({ { 16, gain } });
 }
 
 DemoProjectAudioProcessor::~DemoProjectAudioProcessor()
@@ -69,39 +78,56 @@ double DemoProjectAudioProcessor::getTailLengthSeconds() const
 
 int DemoProjectAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // The bank always has at least one, some hosts don't cope very well if you tell them there are 0 programs.
+    return presets.getNumPresets();
 }
 
 int DemoProjectAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getCurrentPreset();
 }
 
 void DemoProjectAudioProcessor::setCurrentProgram (int index)
 {
+    // The new values are picked up at the start of the next block.
+    presets.loadPreset(index);
 }
 
 const juce::String DemoProjectAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getPresetName(index);
 }
 
 void DemoProjectAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    // The factory presets can't be renamed.
 }
 
 //==============================================================================
 void DemoProjectAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    // The load is worked out against how long each block lasts at this rate.
+    profiler.prepare(sampleRate);
+
+    // From here on, presets wait for the start of a block.
+    presets.prepare();
+
+    // Only one of these is used at a time, but both are tiny so they are both kept ready.
+    gainStage.prepare(sampleRate, samplesPerBlock);
+    gainStage.reset(gain->get());
+
+    doubleGainStage.prepare(sampleRate, samplesPerBlock);
+    doubleGainStage.reset(gain->get());
+
+    // A gain has no memory, so there is no tail to wait for once the input goes quiet.
+    silenceDetector.setTailLength(0);
+    silenceDetector.reset();
 }
 
 void DemoProjectAudioProcessor::releaseResources()
 {
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
+    // There won't be any more blocks, so a preset that is still waiting is applied straight away.
+    presets.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -132,26 +158,64 @@ bool DemoProjectAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 
 void DemoProjectAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    auto* channelDataL = buffer.getWritePointer(0);
-    auto* channelDataR = buffer.getWritePointer(1);
+    BlockProfiler::ScopedTimer timer(profiler, buffer.getNumSamples());
+
+    // Flushes denormals to zero for the rest of the block, a gain fading towards 0 would otherwise slow right down.
+    juce::ScopedNoDenormals noDenormals;
+
+    presets.applyPendingValues();
+
+    if (skipSilentBlock(buffer, midiMessages, gainStage))
+        return;
+
+    // A MIDI controller can move the gain part way through, so each part between them is processed on its own.
+    splitter.process(buffer, midiMessages, [this](auto& subBlock) { processSamples(subBlock, gainStage); });
+}
+
+void DemoProjectAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // The same steps as the float version above, with the double precision gain stage.
+    BlockProfiler::ScopedTimer timer(profiler, buffer.getNumSamples());
+
+    juce::ScopedNoDenormals noDenormals;
+
+    presets.applyPendingValues();
 
-    for (int i = 0; i < buffer.getNumSamples(); ++i)
-    {
-        // Set the variable ipnut as one sample data that will change with each iteration of the loop.
-        auto inputL = channelDataL[i];
-        auto inputR = channelDataR[i];
-        
-        // Mute this channel of data
-        //inputL = inputL * 0.0f;
+    if (skipSilentBlock(buffer, midiMessages, doubleGainStage))
+        return;
 
-        // Get the value of the gain parameter and multiply it by the current sample
-        inputL = inputL * gain->get();
-        inputR = inputR * gain->get();
+    splitter.process(buffer, midiMessages, [this](auto& subBlock) { processSamples(subBlock, doubleGainStage); });
+}
+
+bool DemoProjectAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+bool DemoProjectAudioProcessor::skipSilentBlock(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages, GainStage<SampleType>& stage)
+{
+    // The whole block is checked at once, so the hold and tail don't depend on how controllers split it.
+    if (! silenceDetector.process(buffer))
+        return false;
+
+    // Nothing is processed, but the controllers in the block still move the gain.
+    splitter.applyAll(midiMessages);
+
+    // Silence times any gain is still silence, so the gain jumps straight to its new value and the loop is skipped.
+    stage.reset((SampleType) gain->get());
+    buffer.clear();
+    return true;
+}
+
+template <typename SampleType>
+void DemoProjectAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer, GainStage<SampleType>& stage)
+{
+    // Get the value of the gain parameter once for the whole block, it is an atomic load each time.
+    stage.setGain((SampleType) gain->get());
 
-        // Write the input back into the channelData
-        channelDataL[i] = inputL;
-        channelDataR[i] = inputR;
-    }
+    // Multiply every channel by it in place, ramping only while the gain is still moving.
+    stage.process(buffer);
 }
 
 //==============================================================================
@@ -164,22 +228,21 @@ juce::AudioProcessorEditor* DemoProjectAudioProcessor::createEditor()
 {
     //return new DemoProjectAudioProcessorEditor (*this);
 
-    // Use the generic UI supplied with JUCE
-    return new juce::GenericAudioProcessorEditor(this);
+    // Use the generic UI supplied with JUCE, with the profiler's figures underneath.
+    return new ProfiledGenericEditor(*this, profiler);
 }
 
 //==============================================================================
 void DemoProjectAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    // Every parameter by ID with its real value, and the preset that was loaded.
+    presets.saveState(stateVersion, destData);
 }
 
 void DemoProjectAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    // Sessions saved before there was any state are empty, and leave the gain where it is.
+    presets.restoreState(data, sizeInBytes, stateVersion);
 }
 
 //==============================================================================
@@ -9,6 +9,11 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../../Shared/GainStage.h"
+#include "../../Shared/BlockProfiler.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
+#include "../../Shared/BlockSplitter.h"
 
 //==============================================================================
 /**
@@ -32,6 +37,10 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    // The gain has a double version, so 64 bit hosts don't have to convert each block to floats.
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -56,9 +65,39 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    // How long each processBlock call takes, for the editor to show.
+    BlockProfiler& getProfiler() noexcept { return profiler; }
+
 private:
     juce::AudioParameterFloat* gain;
 
+    // Applies the gain to one part of the block, with the stage that matches the buffer's precision.
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer, GainStage<SampleType>& stage);
+
+    // Checks the whole block for silence before it is split, and clears it if it can be skipped.
+    template <typename SampleType>
+    bool skipSilentBlock(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages, GainStage<SampleType>& stage);
+
+    // Applies the gain to every channel, ramping only when it changes. There is one for each precision.
+    GainStage<float> gainStage;
+    GainStage<double> doubleGainStage;
+
+    // Skips the gain altogether while the input is silent.
+    SilenceDetector silenceDetector;
+
+    // Cuts each block wherever a MIDI controller moves a parameter, so the change lands on the right sample.
+    BlockSplitter splitter;
+
+    // Times every processBlock call without locking or allocating on the audio thread.
+    BlockProfiler profiler;
+
+    // The factory presets. Presets and restored sessions are applied all at once at the start of a block.
+    PresetBank presets { *this };
+
+    // Bump this, and pass a migration to restoreState(), when a change needs more than new parameters getting their defaults.
+    static constexpr int stateVersion = 1;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DemoProjectAudioProcessor)
 };
@@ -0,0 +1,24 @@
+/*
+  ==============================================================================
+
+    AntiderivativeClipper.cpp
+    Created: 17 Oct 2026 3:21:55pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "AntiderivativeClipper.h"
+
+//==============================================================================
+void AntiderivativeClipper::prepare (int numChannels)
+{
+    states.resize ((size_t) juce::jmax (1, numChannels));
+    reset();
+}
+
+void AntiderivativeClipper::reset() noexcept
+{
+    for (auto& state : states)
+        state = {};
+}
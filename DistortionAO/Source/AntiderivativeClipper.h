@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    AntiderivativeClipper.h
+    Created: 17 Oct 2026 3:21:55pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Antiderivative anti-aliasing (ADAA) versions of the clipping curves.
+
+    Instead of applying the curve to each sample, first order ADAA takes the
+    average of the curve over the line between the last sample and this one,
+    (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]), where F1 is the curve's
+    antiderivative. Second order does the same again with F2, the antiderivative
+    of F1. This removes most of the aliasing without oversampling.
+
+    When neighbouring samples are too close together the divisions become
+    ill-conditioned, so the curve is evaluated at the midpoint instead.
+
+    The wet signal comes out half a sample (first order) or one sample (second
+    order) late, which is small enough to leave the dry signal as it is.
+
+    The maths is always done in doubles, so the float and double versions only
+    differ in what they read and write.
+*/
+class AntiderivativeClipper
+{
+public:
+    /** Hard clipping and its first two antiderivatives. */
+    struct HardClip
+    {
+        static double curve (double x, double t) noexcept
+        {
+            return juce::jlimit (-t, t, x);
+        }
+
+        static double firstAntiderivative (double x, double t) noexcept
+        {
+            auto a = std::abs (x);
+            return a <= t ? 0.5 * x * x : t * a - 0.5 * t * t;
+        }
+
+        static double secondAntiderivative (double x, double t) noexcept
+        {
+            auto a = std::abs (x);
+
+            if (a <= t)
+                return x * x * x / 6.0;
+
+            return std::copysign (0.5 * t * a * a - 0.5 * t * t * a + t * t * t / 6.0, x);
+        }
+    };
+
+    /** The exp soft clip and its first two antiderivatives. */
+    struct SoftClip
+    {
+        static double curve (double x, double t) noexcept
+        {
+            auto a = std::abs (x);
+            return a <= t ? x : std::copysign (1.0 - std::exp (-a), x);
+        }
+
+        static double firstAntiderivative (double x, double t) noexcept
+        {
+            auto a = std::abs (x);
+
+            if (a <= t)
+                return 0.5 * x * x;
+
+            return 0.5 * t * t + (a - t) + std::exp (-a) - std::exp (-t);
+        }
+
+        static double secondAntiderivative (double x, double t) noexcept
+        {
+            auto a = std::abs (x);
+
+            if (a <= t)
+                return x * x * x / 6.0;
+
+            auto d = a - t;
+            auto expT = std::exp (-t);
+
+            return std::copysign (t * t * t / 6.0 + 0.5 * t * t * d + 0.5 * d * d + (expT - std::exp (-a)) - expT * d, x);
+        }
+    };
+
+    //==============================================================================
+    AntiderivativeClipper() = default;
+
+    /** Allocates the per-channel state, call this from prepareToPlay(). */
+    void prepare (int numChannels);
+
+    /** Forgets the previous samples of every channel. */
+    void reset() noexcept;
+
+    /** First order ADAA over one channel, blended with the clean signal. */
+    template <typename Curve, typename SampleType>
+    void processFirstOrder (int channel, SampleType* data, int numSamples, SampleType threshold, SampleType mix) noexcept
+    {
+        if (! juce::isPositiveAndBelow (channel, (int) states.size()))
+            return;
+
+        auto& state = states[(size_t) channel];
+        const auto t = (double) threshold;
+
+        auto x1 = state.x1;
+        auto x2 = state.x2;
+        auto f1 = Curve::firstAntiderivative (x1, t);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            auto cleanOut = data[sample];
+            auto x0 = (double) cleanOut;
+            auto f0 = Curve::firstAntiderivative (x0, t);
+
+            auto difference = x0 - x1;
+            auto input = std::abs (difference) < tolerance ? Curve::curve (0.5 * (x0 + x1), t)
+                                                           : (f0 - f1) / difference;
+
+            // Finally return the sample with the correct dry / wet ratio
+            data[sample] = ((1 - mix) * cleanOut) + (mix * (SampleType) input);
+
+            x2 = x1;
+            x1 = x0;
+            f1 = f0;
+        }
+
+        state.x1 = x1;
+        state.x2 = x2;
+    }
+
+    /** Second order ADAA over one channel, blended with the clean signal. */
+    template <typename Curve, typename SampleType>
+    void processSecondOrder (int channel, SampleType* data, int numSamples, SampleType threshold, SampleType mix) noexcept
+    {
+        if (! juce::isPositiveAndBelow (channel, (int) states.size()))
+            return;
+
+        auto& state = states[(size_t) channel];
+        const auto t = (double) threshold;
+
+        auto x1 = state.x1;
+        auto x2 = state.x2;
+
+        // The threshold may have moved since the last block, so rebuild the previous divided difference.
+        auto d2 = dividedDifference<Curve> (x1, x2, t);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            auto cleanOut = data[sample];
+            auto x0 = (double) cleanOut;
+            auto d1 = dividedDifference<Curve> (x0, x1, t);
+
+            auto difference = x0 - x2;
+            auto input = std::abs (difference) < tolerance ? fallback<Curve> (x0, x1, x2, t)
+                                                           : (2.0 / difference) * (d1 - d2);
+
+            // Finally return the sample with the correct dry / wet ratio
+            data[sample] = ((1 - mix) * cleanOut) + (mix * (SampleType) input);
+
+            d2 = d1;
+            x2 = x1;
+            x1 = x0;
+        }
+
+        state.x1 = x1;
+        state.x2 = x2;
+    }
+
+private:
+    // Below this the differences between samples are too small to divide by.
+    static constexpr double tolerance = 1.0e-5;
+
+    // (F2(x0) - F2(x1)) / (x0 - x1), or F1 at the midpoint when the samples are too close.
+    template <typename Curve>
+    static double dividedDifference (double x0, double x1, double t) noexcept
+    {
+        auto difference = x0 - x1;
+
+        if (std::abs (difference) < tolerance)
+            return Curve::firstAntiderivative (0.5 * (x0 + x1), t);
+
+        return (Curve::secondAntiderivative (x0, t) - Curve::secondAntiderivative (x1, t)) / difference;
+    }
+
+    // Used when x[n] and x[n-2] are nearly equal, which would otherwise divide by zero.
+    template <typename Curve>
+    static double fallback (double x0, double x1, double x2, double t) noexcept
+    {
+        auto xBar = 0.5 * (x0 + x2);
+        auto delta = xBar - x1;
+
+        if (std::abs (delta) < tolerance)
+            return Curve::curve (0.5 * (xBar + x1), t);
+
+        return (2.0 / delta) * (Curve::firstAntiderivative (xBar, t)
+                                 + (Curve::secondAntiderivative (x1, t) - Curve::secondAntiderivative (xBar, t)) / delta);
+    }
+
+    // The last two input samples of a channel.
+    struct ChannelState
+    {
+        double x1 = 0.0;
+        double x2 = 0.0;
+    };
+
+    std::vector<ChannelState> states;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AntiderivativeClipper)
+};
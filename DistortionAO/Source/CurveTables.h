@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    CurveTables.h
+    Created: 17 Oct 2026 10:24:03pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Shared/SimdOps.h"
+
+//==============================================================================
+/**
+    Lookup tables for the curves that would otherwise need a tanh or atan for
+    every sample.
+
+    The tables are filled in by the compiler, so there is nothing to build when
+    the plugin loads. std::tanh and std::atan can't be used in a constant
+    expression, hence the small series versions below, which are only ever run
+    at compile time.
+
+    Each table holds a saturating shape s(u) for u from 0 to infinity, stored
+    against v = u / (1 + u) so that the whole curve fits between 0 and 1 and
+    there is no cut off point where the table stops. Reading one linearly
+    interpolates between the two nearest points, which keeps the error below
+    1e-6, and the table itself is 4kB so it sits in the L1 cache.
+*/
+namespace CurveTables
+{
+inline namespace SIMDOPS_TARGET
+{
+    namespace Maths
+    {
+        constexpr double pi = 3.14159265358979323846;
+        constexpr double ln2 = 0.69314718055994530942;
+
+        /** e^x. Reduces x to n * ln(2) + r, with r no bigger than ln(2) / 2, and sums the Taylor series for e^r. */
+        constexpr double exp (double x)
+        {
+            auto n = (int) (x / ln2 + (x < 0.0 ? -0.5 : 0.5));
+            auto r = x - n * ln2;
+
+            double term = 1.0, sum = 1.0;
+
+            for (int i = 1; i < 16; ++i)
+            {
+                term *= r / i;
+                sum += term;
+            }
+
+            for (; n > 0; --n)  sum *= 2.0;
+            for (; n < 0; ++n)  sum *= 0.5;
+
+            return sum;
+        }
+
+        constexpr double tanh (double x)
+        {
+            auto e = exp (-2.0 * (x < 0.0 ? -x : x));
+            auto result = (1.0 - e) / (1.0 + e);
+            return x < 0.0 ? -result : result;
+        }
+
+        /** atan(x). Folds x into 0 to tan(pi / 8), where the Taylor series converges quickly. */
+        constexpr double atan (double x)
+        {
+            auto a = x < 0.0 ? -x : x;
+
+            // atan(a) = pi / 2 - atan(1 / a)
+            auto inverted = a > 1.0;
+
+            if (inverted)
+                a = 1.0 / a;
+
+            // atan(a) = pi / 4 + atan((a - 1) / (a + 1))
+            auto offset = 0.0;
+
+            if (a > 0.41421356237309503)
+            {
+                a = (a - 1.0) / (a + 1.0);
+                offset = pi / 4.0;
+            }
+
+            double power = a, sum = 0.0;
+
+            for (int k = 0; k < 24; ++k)
+            {
+                sum += (k % 2 == 0 ? power : -power) / (2 * k + 1);
+                power *= a * a;
+            }
+
+            auto result = offset + sum;
+
+            if (inverted)
+                result = pi / 2.0 - result;
+
+            return x < 0.0 ? -result : result;
+        }
+    }
+
+    //==============================================================================
+    /** A curve sampled at numPoints evenly spaced points from 0 to 1, with linear interpolation in between. */
+    template <int numPoints>
+    struct Table
+    {
+        template <typename Function>
+        constexpr explicit Table (Function function)
+        {
+            for (int i = 0; i < numPoints; ++i)
+                values[i] = (float) function ((double) i / (numPoints - 1));
+
+            // A copy of the last point, so reading at exactly 1 can still interpolate.
+            values[numPoints] = values[numPoints - 1];
+        }
+
+        /** Reads the table at a position from 0 to 1, anything outside that is clamped. */
+        template <typename SampleType>
+        SampleType interpolate (SampleType position) const noexcept
+        {
+            auto scaled = juce::jlimit ((SampleType) 0, (SampleType) 1, position) * (SampleType) (numPoints - 1);
+            auto index = (int) scaled;
+            auto fraction = scaled - (SampleType) index;
+
+            return (SampleType) values[index] + fraction * (SampleType) (values[index + 1] - values[index]);
+        }
+
+        /** Reads the table for every lane of a register. There is no gather in SSE2 or NEON, so the lanes are read one at a time. */
+        template <typename Ops>
+        typename Ops::Vec lookup (typename Ops::Vec positions) const noexcept
+        {
+            typename Ops::Sample lanes[Ops::width];
+            Ops::store (lanes, positions);
+
+            for (auto& lane : lanes)
+                lane = interpolate (lane);
+
+            return Ops::load (lanes);
+        }
+
+        float values[numPoints + 1] {};
+    };
+
+    /** Enough points for the interpolation error to stay under 1e-6, and few enough for the compiler to fill them quickly. */
+    constexpr int numTablePoints = 1024;
+
+    /** tanh(u). */
+    inline constexpr Table<numTablePoints> tanh { [] (double v)
+    {
+        return v >= 1.0 ? 1.0 : Maths::tanh (v / (1.0 - v));
+    } };
+
+    /** atan scaled so it starts with a slope of 1 and ends at 1, 2 / pi * atan(pi / 2 * u). */
+    inline constexpr Table<numTablePoints> arctan { [] (double v)
+    {
+        return v >= 1.0 ? 1.0 : 2.0 / Maths::pi * Maths::atan (Maths::pi / 2.0 * v / (1.0 - v));
+    } };
+}
+}
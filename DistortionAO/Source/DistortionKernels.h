@@ -0,0 +1,525 @@
+/*
+  ==============================================================================
+
+    DistortionKernels.h
+    Created: 17 Oct 2026 11:04:18am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Shared/SimdOps.h"
+#include "CurveTables.h"
+
+//==============================================================================
+/**
+    One block kernel per distortion type.
+
+    processBlock picks the kernel once per channel instead of switching on the
+    menu choice for every sample. Each curve is written without branches, the
+    thresholds are min / max clamps and selects, and runs four samples at a time
+    on SSE or NEON. The dry / wet mix is done in the same pass over the samples.
+    Every kernel works on floats or doubles, picking the matching ops for each.
+
+    A curve is a policy type templated on the ops, with a Settings type, a
+    prepare() that works out the settings from the threshold once per block, and
+    an apply() for one register of samples. processLanes() is written once and
+    the compiler builds a fully inlined copy of it for every curve, so adding a
+    curve only means writing a new policy and a case in visitCurve().
+
+    The stereo linked and mid / side kernels work on both channels of a pair at
+    once, so the linking, or the encode, the curve and the decode, all happen in
+    the one pass over the samples.
+
+    On x86 everything here is also compiled with AVX2 in DistortionKernelsAvx2.cpp.
+    The process() functions that take a CurveType hand the block over to that copy
+    when the CPU has AVX2, which doubles the lanes without needing an AVX2 build.
+*/
+namespace DistortionKernels
+{
+    /** Every curve that can be picked at run time. */
+    enum class CurveType
+    {
+        hardClip,
+        softClip,
+        halfWaveRectifier,
+        tanh,
+        arctan,
+        cubic,
+        asymmetric
+    };
+
+   #if JUCE_INTEL
+    /** The same kernels compiled again with AVX2 turned on, in DistortionKernelsAvx2.cpp.
+        Only call these when canUseAvx2() says the CPU has it, the process() functions below
+        already do that check for you.
+    */
+    namespace Avx2
+    {
+        void process (CurveType curve, float* data, int numSamples, float threshold, float mix) noexcept;
+        void process (CurveType curve, double* data, int numSamples, double threshold, double mix) noexcept;
+
+        void processLinked (CurveType curve, float* left, float* right, int numSamples, float threshold, float mix) noexcept;
+        void processLinked (CurveType curve, double* left, double* right, int numSamples, double threshold, double mix) noexcept;
+
+        void processMidSide (CurveType curve, float* left, float* right, int numSamples,
+                             float midThreshold, float midMix, float sideThreshold, float sideMix) noexcept;
+        void processMidSide (CurveType curve, double* left, double* right, int numSamples,
+                             double midThreshold, double midMix, double sideThreshold, double sideMix) noexcept;
+    }
+   #endif
+
+inline namespace SIMDOPS_TARGET
+{
+    /** Hard Clipping clips the sample's value to the threshold when its absolute value is greater than the threshold. */
+    template <typename Ops>
+    struct HardClip
+    {
+        using Vec = typename Ops::Vec;
+        using Sample = typename Ops::Sample;
+
+        struct Settings
+        {
+            Vec threshold, negativeThreshold;
+        };
+
+        static Settings prepare (Sample threshold) noexcept
+        {
+            return { Ops::set (threshold), Ops::set (-threshold) };
+        }
+
+        static Vec apply (Vec input, const Settings& settings) noexcept
+        {
+            return Ops::min (Ops::max (input, settings.negativeThreshold), settings.threshold);
+        }
+    };
+
+    /** Similar to Hard Clipping except its input is slightly pushed away with the exp function. */
+    template <typename Ops>
+    struct SoftClip
+    {
+        using Vec = typename Ops::Vec;
+        using Sample = typename Ops::Sample;
+        using Settings = Vec;
+
+        static Settings prepare (Sample threshold) noexcept
+        {
+            return Ops::set (threshold);
+        }
+
+        static Vec apply (Vec input, Vec threshold) noexcept
+        {
+            auto magnitude = Ops::abs (input);
+
+            // 1 - e^-x above the threshold and -1 + e^x below it are the same curve mirrored.
+            auto shaped = Ops::sub (Ops::set (1.0f), SimdOps::expNegative<Ops> (Ops::sub (Ops::set (0.0f), magnitude)));
+
+            return Ops::select (Ops::greaterThan (magnitude, threshold), Ops::copySign (shaped, input), input);
+        }
+    };
+
+    /** Only keeps the part of the waveform above the threshold. */
+    template <typename Ops>
+    struct HalfWaveRectifier
+    {
+        using Vec = typename Ops::Vec;
+        using Sample = typename Ops::Sample;
+        using Settings = Vec;
+
+        static Settings prepare (Sample threshold) noexcept
+        {
+            return Ops::set (threshold);
+        }
+
+        static Vec apply (Vec input, Vec threshold) noexcept
+        {
+            return Ops::select (Ops::greaterThan (input, threshold), input, Ops::set (0.0f));
+        }
+    };
+
+    //==============================================================================
+    /** The shapes the smooth curves bend over with. Each takes u >= 0 and returns s(u), which starts
+        at 0 with a slope of 1 and flattens out towards 1.
+    */
+    namespace Shapes
+    {
+        /** tanh(u), read from the compile time table. */
+        struct TanhTable
+        {
+            template <typename Ops>
+            static typename Ops::Vec evaluate (typename Ops::Vec u) noexcept
+            {
+                auto position = Ops::div (u, Ops::add (u, Ops::set (1.0f)));
+                return CurveTables::tanh.lookup<Ops> (position);
+            }
+        };
+
+        /** 2 / pi * atan(pi / 2 * u), read from the compile time table. */
+        struct ArctanTable
+        {
+            template <typename Ops>
+            static typename Ops::Vec evaluate (typename Ops::Vec u) noexcept
+            {
+                auto position = Ops::div (u, Ops::add (u, Ops::set (1.0f)));
+                return CurveTables::arctan.lookup<Ops> (position);
+            }
+        };
+
+        /** The same two shapes worked out exactly with the standard library, one lane at a time.
+            They are slower, but the benchmarks use them to check the tables.
+        */
+        struct TanhExact
+        {
+            template <typename Ops>
+            static typename Ops::Vec evaluate (typename Ops::Vec u) noexcept
+            {
+                typename Ops::Sample lanes[Ops::width];
+                Ops::store (lanes, u);
+
+                for (auto& lane : lanes)
+                    lane = std::tanh (lane);
+
+                return Ops::load (lanes);
+            }
+        };
+
+        struct ArctanExact
+        {
+            template <typename Ops>
+            static typename Ops::Vec evaluate (typename Ops::Vec u) noexcept
+            {
+                using Sample = typename Ops::Sample;
+
+                Sample lanes[Ops::width];
+                Ops::store (lanes, u);
+
+                for (auto& lane : lanes)
+                    lane = (Sample) (2.0 / CurveTables::Maths::pi) * std::atan ((Sample) (CurveTables::Maths::pi / 2.0) * lane);
+
+                return Ops::load (lanes);
+            }
+        };
+
+        /** u - 4/27 u^3, which reaches 1 with a slope of 0 at u = 1.5 and stays there. Cheap enough to not need a table. */
+        struct Cubic
+        {
+            template <typename Ops>
+            static typename Ops::Vec evaluate (typename Ops::Vec u) noexcept
+            {
+                auto x = Ops::min (u, Ops::set (1.5f));
+                return Ops::sub (x, Ops::mul (Ops::set ((typename Ops::Sample) 4 / 27), Ops::mul (x, Ops::mul (x, x))));
+            }
+        };
+    }
+
+    /** Passes the signal straight through up to the threshold, then bends it over with the shape so
+        it meets 1 (or -1) smoothly. The shape is squeezed into the space left above the threshold, so
+        the curve and its slope don't jump at the threshold.
+    */
+    template <typename Ops, typename Shape>
+    struct SaturatingKnee
+    {
+        using Vec = typename Ops::Vec;
+        using Sample = typename Ops::Sample;
+
+        struct Settings
+        {
+            Vec threshold, range, inverseRange;
+        };
+
+        static Settings prepare (Sample threshold) noexcept
+        {
+            // At a threshold of 1 there is no room left to bend in, so the curve becomes a hard clip at 1.
+            auto range = (Sample) 1 - threshold;
+            return { Ops::set (threshold), Ops::set (range), Ops::set (range > (Sample) 1.0e-6 ? (Sample) 1 / range : (Sample) 0) };
+        }
+
+        static Vec apply (Vec input, const Settings& settings) noexcept
+        {
+            auto magnitude = Ops::abs (input);
+            auto overshoot = Ops::mul (Ops::max (Ops::sub (magnitude, settings.threshold), Ops::set (0.0f)), settings.inverseRange);
+            auto shaped = Ops::add (settings.threshold, Ops::mul (settings.range, Shape::template evaluate<Ops> (overshoot)));
+
+            return Ops::select (Ops::greaterThan (magnitude, settings.threshold), Ops::copySign (shaped, input), input);
+        }
+    };
+
+    template <typename Ops> using Tanh = SaturatingKnee<Ops, Shapes::TanhTable>;
+    template <typename Ops> using Arctan = SaturatingKnee<Ops, Shapes::ArctanTable>;
+    template <typename Ops> using Cubic = SaturatingKnee<Ops, Shapes::Cubic>;
+
+    template <typename Ops> using TanhExact = SaturatingKnee<Ops, Shapes::TanhExact>;
+    template <typename Ops> using ArctanExact = SaturatingKnee<Ops, Shapes::ArctanExact>;
+
+    /** Bends the top half over like Tanh, but hard clips the bottom half at the threshold, which adds even harmonics. */
+    template <typename Ops>
+    struct Asymmetric
+    {
+        using Vec = typename Ops::Vec;
+        using Sample = typename Ops::Sample;
+
+        struct Settings
+        {
+            typename Tanh<Ops>::Settings positive;
+            Vec negativeThreshold;
+        };
+
+        static Settings prepare (Sample threshold) noexcept
+        {
+            return { Tanh<Ops>::prepare (threshold), Ops::set (-threshold) };
+        }
+
+        static Vec apply (Vec input, const Settings& settings) noexcept
+        {
+            return Ops::max (Tanh<Ops>::apply (input, settings.positive), settings.negativeThreshold);
+        }
+    };
+
+    //==============================================================================
+    /** Runs a curve over one channel and blends it with the clean signal.
+
+        Whole SIMD registers are processed first, then the scalar version of the
+        same curve picks up the last few samples.
+    */
+    template <template <typename> class Curve, typename Ops>
+    inline int processLanes (typename Ops::Sample* data, int numSamples, typename Ops::Sample threshold, typename Ops::Sample mix) noexcept
+    {
+        const auto settings = Curve<Ops>::prepare (threshold);
+        auto wetGain = Ops::set (mix);
+        auto dryGain = Ops::set (1 - mix);
+
+        int sample = 0;
+
+        for (; sample + Ops::width <= numSamples; sample += Ops::width)
+        {
+            auto cleanOut = Ops::load (data + sample);
+            auto input = Curve<Ops>::apply (cleanOut, settings);
+
+            // Finally return the sample with the correct dry / wet ratio.
+            Ops::store (data + sample, Ops::add (Ops::mul (dryGain, cleanOut), Ops::mul (wetGain, input)));
+        }
+
+        return sample;
+    }
+
+    template <template <typename> class Curve, typename SampleType>
+    inline void process (SampleType* data, int numSamples, SampleType threshold, SampleType mix) noexcept
+    {
+        auto done = processLanes<Curve, SimdOps::NativeFor<SampleType>> (data, numSamples, threshold, mix);
+
+        if (done < numSamples)
+            processLanes<Curve, SimdOps::ScalarFor<SampleType>> (data + done, numSamples - done, threshold, mix);
+    }
+
+    //==============================================================================
+    /** Stereo linked: the louder of each pair of samples goes through the curve, sign and all, and
+        both channels are scaled by the same gain, f(x) / x, so the balance between them never moves.
+        Feeding the curve the signed sample keeps the one-sided curves one-sided: the rectifier still
+        shuts the pair off when the louder sample is negative, and Asymmetric still clamps below zero.
+        Both channels are read and written in the same pass.
+    */
+    template <template <typename> class Curve, typename Ops>
+    inline int processLinkedLanes (typename Ops::Sample* left, typename Ops::Sample* right, int numSamples,
+                                   typename Ops::Sample threshold, typename Ops::Sample mix) noexcept
+    {
+        using Sample = typename Ops::Sample;
+
+        const auto settings = Curve<Ops>::prepare (threshold);
+        auto wetGain = Ops::set (mix);
+        auto dryGain = Ops::set (1 - mix);
+
+        // Keeps the gain's divide away from zero. Anything this quiet comes out as silence either way.
+        auto smallest = Ops::set ((Sample) 1.0e-30);
+
+        int sample = 0;
+
+        for (; sample + Ops::width <= numSamples; sample += Ops::width)
+        {
+            auto leftIn = Ops::load (left + sample);
+            auto rightIn = Ops::load (right + sample);
+
+            // Whichever of the pair is further from zero, with its own sign.
+            auto louder = Ops::select (Ops::greaterThan (Ops::abs (rightIn), Ops::abs (leftIn)), rightIn, leftIn);
+            auto divisor = Ops::copySign (Ops::max (Ops::abs (louder), smallest), louder);
+            auto gain = Ops::div (Curve<Ops>::apply (louder, settings), divisor);
+
+            // The dry / wet blend of x and x * gain is just x times a blended gain.
+            gain = Ops::add (dryGain, Ops::mul (wetGain, gain));
+
+            Ops::store (left + sample, Ops::mul (leftIn, gain));
+            Ops::store (right + sample, Ops::mul (rightIn, gain));
+        }
+
+        return sample;
+    }
+
+    /** Mid / side: each pair of samples is encoded, the mid and side each go through the curve with
+        their own threshold and mix, and the pair is decoded again, all in one pass over both channels.
+    */
+    template <template <typename> class Curve, typename Ops>
+    inline int processMidSideLanes (typename Ops::Sample* left, typename Ops::Sample* right, int numSamples,
+                                    typename Ops::Sample midThreshold, typename Ops::Sample midMix,
+                                    typename Ops::Sample sideThreshold, typename Ops::Sample sideMix) noexcept
+    {
+        using Sample = typename Ops::Sample;
+
+        const auto midSettings = Curve<Ops>::prepare (midThreshold);
+        const auto sideSettings = Curve<Ops>::prepare (sideThreshold);
+        auto midWet = Ops::set (midMix), midDry = Ops::set (1 - midMix);
+        auto sideWet = Ops::set (sideMix), sideDry = Ops::set (1 - sideMix);
+        auto half = Ops::set ((Sample) 0.5);
+
+        int sample = 0;
+
+        for (; sample + Ops::width <= numSamples; sample += Ops::width)
+        {
+            auto leftIn = Ops::load (left + sample);
+            auto rightIn = Ops::load (right + sample);
+
+            auto mid = Ops::mul (Ops::add (leftIn, rightIn), half);
+            auto side = Ops::mul (Ops::sub (leftIn, rightIn), half);
+
+            mid = Ops::add (Ops::mul (midDry, mid), Ops::mul (midWet, Curve<Ops>::apply (mid, midSettings)));
+            side = Ops::add (Ops::mul (sideDry, side), Ops::mul (sideWet, Curve<Ops>::apply (side, sideSettings)));
+
+            Ops::store (left + sample, Ops::add (mid, side));
+            Ops::store (right + sample, Ops::sub (mid, side));
+        }
+
+        return sample;
+    }
+
+    template <template <typename> class Curve, typename SampleType>
+    inline void processLinked (SampleType* left, SampleType* right, int numSamples, SampleType threshold, SampleType mix) noexcept
+    {
+        auto done = processLinkedLanes<Curve, SimdOps::NativeFor<SampleType>> (left, right, numSamples, threshold, mix);
+
+        if (done < numSamples)
+            processLinkedLanes<Curve, SimdOps::ScalarFor<SampleType>> (left + done, right + done, numSamples - done, threshold, mix);
+    }
+
+    template <template <typename> class Curve, typename SampleType>
+    inline void processMidSide (SampleType* left, SampleType* right, int numSamples,
+                                SampleType midThreshold, SampleType midMix, SampleType sideThreshold, SampleType sideMix) noexcept
+    {
+        auto done = processMidSideLanes<Curve, SimdOps::NativeFor<SampleType>> (left, right, numSamples,
+                                                                                  midThreshold, midMix, sideThreshold, sideMix);
+
+        if (done < numSamples)
+            processMidSideLanes<Curve, SimdOps::ScalarFor<SampleType>> (left + done, right + done, numSamples - done,
+                                                                         midThreshold, midMix, sideThreshold, sideMix);
+    }
+
+    /** Turns a left and right channel into mid and side in place, for the stages that can't have it fused in. */
+    template <typename SampleType>
+    inline void encodeMidSide (SampleType* left, SampleType* right, int numSamples) noexcept
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            auto mid = (left[sample] + right[sample]) * (SampleType) 0.5;
+            auto side = (left[sample] - right[sample]) * (SampleType) 0.5;
+
+            left[sample] = mid;
+            right[sample] = side;
+        }
+    }
+
+    /** Turns mid and side back into left and right in place. */
+    template <typename SampleType>
+    inline void decodeMidSide (SampleType* mid, SampleType* side, int numSamples) noexcept
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            auto left = mid[sample] + side[sample];
+            auto right = mid[sample] - side[sample];
+
+            mid[sample] = left;
+            side[sample] = right;
+        }
+    }
+
+    //==============================================================================
+    /** Stands in for a curve's policy, so a generic lambda can be handed one. */
+    template <template <typename> class Curve>
+    struct CurveTag {};
+
+    /** Calls visitor (CurveTag<Curve>()) with the policy for a curve, once for the whole block.
+        This is the only place the curves are listed.
+    */
+    template <typename Visitor>
+    inline void visitCurve (CurveType curve, Visitor&& visitor) noexcept
+    {
+        switch (curve)
+        {
+            case CurveType::hardClip:           visitor (CurveTag<HardClip>()); break;
+            case CurveType::softClip:           visitor (CurveTag<SoftClip>()); break;
+            case CurveType::halfWaveRectifier:  visitor (CurveTag<HalfWaveRectifier>()); break;
+            case CurveType::tanh:               visitor (CurveTag<Tanh>()); break;
+            case CurveType::arctan:             visitor (CurveTag<Arctan>()); break;
+            case CurveType::cubic:              visitor (CurveTag<Cubic>()); break;
+            case CurveType::asymmetric:         visitor (CurveTag<Asymmetric>()); break;
+            default:                            jassertfalse; break;
+        }
+    }
+
+    /** True when this build can hand the kernels to the AVX2 copy, and the CPU it's running on has AVX2 and FMA.
+        The CPU is only asked once.
+    */
+    inline bool canUseAvx2() noexcept
+    {
+       #if SIMDOPS_DISPATCH_AVX2
+        static const bool hasAvx2 = juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+        return hasAvx2;
+       #else
+        return false;
+       #endif
+    }
+
+    /** Picks the kernel for a curve once for the whole block. */
+    template <typename SampleType>
+    inline void process (CurveType curve, SampleType* data, int numSamples, SampleType threshold, SampleType mix) noexcept
+    {
+       #if SIMDOPS_DISPATCH_AVX2
+        if (canUseAvx2())
+            return Avx2::process (curve, data, numSamples, threshold, mix);
+       #endif
+
+        visitCurve (curve, [&] <template <typename> class Curve> (CurveTag<Curve>)
+        {
+            process<Curve> (data, numSamples, threshold, mix);
+        });
+    }
+
+    template <typename SampleType>
+    inline void processLinked (CurveType curve, SampleType* left, SampleType* right, int numSamples, SampleType threshold, SampleType mix) noexcept
+    {
+       #if SIMDOPS_DISPATCH_AVX2
+        if (canUseAvx2())
+            return Avx2::processLinked (curve, left, right, numSamples, threshold, mix);
+       #endif
+
+        visitCurve (curve, [&] <template <typename> class Curve> (CurveTag<Curve>)
+        {
+            processLinked<Curve> (left, right, numSamples, threshold, mix);
+        });
+    }
+
+    template <typename SampleType>
+    inline void processMidSide (CurveType curve, SampleType* left, SampleType* right, int numSamples,
+                                SampleType midThreshold, SampleType midMix, SampleType sideThreshold, SampleType sideMix) noexcept
+    {
+       #if SIMDOPS_DISPATCH_AVX2
+        if (canUseAvx2())
+            return Avx2::processMidSide (curve, left, right, numSamples, midThreshold, midMix, sideThreshold, sideMix);
+       #endif
+
+        visitCurve (curve, [&] <template <typename> class Curve> (CurveTag<Curve>)
+        {
+            processMidSide<Curve> (left, right, numSamples, midThreshold, midMix, sideThreshold, sideMix);
+        });
+    }
+}
+}
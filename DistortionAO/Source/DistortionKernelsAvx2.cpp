@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    DistortionKernelsAvx2.cpp
+    Created: 18 Oct 2026 10:12:37am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+// This file is built with AVX2 and FMA turned on (the avx2 compiler flag scheme in the .jucer), and nothing
+// else is. Everything it pulls in from DistortionKernels.h lands in the avx2 namespace, so none of it can be
+// mixed up with the SSE2 copy the rest of the plugin uses. Nothing in here runs unless canUseAvx2() is true.
+#include "DistortionKernels.h"
+
+#if JUCE_INTEL
+
+#if ! defined (__AVX2__)
+ #error "DistortionKernelsAvx2.cpp has to be compiled with AVX2, add it to the avx2 compiler flag scheme"
+#endif
+
+namespace DistortionKernels::Avx2
+{
+    void process (CurveType curve, float* data, int numSamples, float threshold, float mix) noexcept
+    {
+        DistortionKernels::process (curve, data, numSamples, threshold, mix);
+    }
+
+    void process (CurveType curve, double* data, int numSamples, double threshold, double mix) noexcept
+    {
+        DistortionKernels::process (curve, data, numSamples, threshold, mix);
+    }
+
+    void processLinked (CurveType curve, float* left, float* right, int numSamples, float threshold, float mix) noexcept
+    {
+        DistortionKernels::processLinked (curve, left, right, numSamples, threshold, mix);
+    }
+
+    void processLinked (CurveType curve, double* left, double* right, int numSamples, double threshold, double mix) noexcept
+    {
+        DistortionKernels::processLinked (curve, left, right, numSamples, threshold, mix);
+    }
+
+    void processMidSide (CurveType curve, float* left, float* right, int numSamples,
+                         float midThreshold, float midMix, float sideThreshold, float sideMix) noexcept
+    {
+        DistortionKernels::processMidSide (curve, left, right, numSamples, midThreshold, midMix, sideThreshold, sideMix);
+    }
+
+    void processMidSide (CurveType curve, double* left, double* right, int numSamples,
+                         double midThreshold, double midMix, double sideThreshold, double sideMix) noexcept
+    {
+        DistortionKernels::processMidSide (curve, left, right, numSamples, midThreshold, midMix, sideThreshold, sideMix);
+    }
+}
+
+#endif
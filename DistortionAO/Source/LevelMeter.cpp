@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+    LevelMeter.cpp
+    Created: 17 Oct 2026 9:05:27pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "LevelMeter.h"
+#include "../../Shared/SimdOps.h"
+
+namespace
+{
+    // How long the peaks take to fall by about 9dB, and the RMS averaging time.
+    constexpr double releaseSeconds = 0.3;
+
+    // Finds the largest absolute value and the sum of squares of one channel in a single pass.
+    template <typename SampleType>
+    std::pair<SampleType, SampleType> findPeakAndSumOfSquares (const SampleType* data, int numSamples) noexcept
+    {
+        using Ops = SimdOps::NativeFor<SampleType>;
+
+        auto peaks = Ops::set (0);
+        auto sums = Ops::set (0);
+
+        int sample = 0;
+
+        for (; sample + Ops::width <= numSamples; sample += Ops::width)
+        {
+            auto input = Ops::load (data + sample);
+            peaks = Ops::max (peaks, Ops::abs (input));
+            sums = Ops::add (sums, Ops::mul (input, input));
+        }
+
+        // Combine the lanes, then pick up the samples that didn't fill a whole register.
+        SampleType peakLanes[Ops::width], sumLanes[Ops::width];
+        Ops::store (peakLanes, peaks);
+        Ops::store (sumLanes, sums);
+
+        SampleType peak = 0, sumOfSquares = 0;
+
+        for (int lane = 0; lane < Ops::width; ++lane)
+        {
+            peak = juce::jmax (peak, peakLanes[lane]);
+            sumOfSquares += sumLanes[lane];
+        }
+
+        for (; sample < numSamples; ++sample)
+        {
+            peak = juce::jmax (peak, std::abs (data[sample]));
+            sumOfSquares += data[sample] * data[sample];
+        }
+
+        return { peak, sumOfSquares };
+    }
+}
+
+//==============================================================================
+void LevelMeter::prepare (double newSampleRate, int numChannels)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    numMeteredChannels = juce::jlimit (0, maxChannels, numChannels);
+    reset();
+}
+
+void LevelMeter::reset() noexcept
+{
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        inputBlock[channel] = outputBlock[channel] = {};
+        inputMeters[channel] = outputMeters[channel] = {};
+
+        published[channel].inputPeak = 0.0f;
+        published[channel].inputRms = 0.0f;
+        published[channel].outputPeak = 0.0f;
+        published[channel].outputRms = 0.0f;
+    }
+}
+
+template <typename SampleType>
+void LevelMeter::measureInput (const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    measure (buffer, inputBlock, juce::jmin (buffer.getNumChannels(), maxChannels));
+}
+
+template <typename SampleType>
+void LevelMeter::measureOutput (const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    auto numChannels = juce::jmin (buffer.getNumChannels(), maxChannels);
+
+    measure (buffer, outputBlock, numChannels);
+    publish (numChannels, buffer.getNumSamples());
+}
+
+void LevelMeter::measureSilence (int numSamples) noexcept
+{
+    auto numChannels = getNumChannels();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        inputBlock[channel] = outputBlock[channel] = {};
+
+    publish (numChannels, numSamples);
+}
+
+void LevelMeter::publish (int numChannels, int numSamples) noexcept
+{
+    auto decay = getDecay (numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        inputMeters[channel].update (inputBlock[channel], numSamples, decay);
+        outputMeters[channel].update (outputBlock[channel], numSamples, decay);
+
+        // Relaxed is enough, each value stands on its own and the editor only ever looks at the latest one.
+        published[channel].inputPeak.store (inputMeters[channel].peak, std::memory_order_relaxed);
+        published[channel].inputRms.store (std::sqrt (inputMeters[channel].meanSquare), std::memory_order_relaxed);
+        published[channel].outputPeak.store (outputMeters[channel].peak, std::memory_order_relaxed);
+        published[channel].outputRms.store (std::sqrt (outputMeters[channel].meanSquare), std::memory_order_relaxed);
+    }
+}
+
+LevelMeter::Reading LevelMeter::getReading (int channel) const noexcept
+{
+    Reading reading;
+
+    if (! juce::isPositiveAndBelow (channel, maxChannels))
+        return reading;
+
+    auto& levels = published[channel];
+    reading.inputPeak = levels.inputPeak.load (std::memory_order_relaxed);
+    reading.inputRms = levels.inputRms.load (std::memory_order_relaxed);
+    reading.outputPeak = levels.outputPeak.load (std::memory_order_relaxed);
+    reading.outputRms = levels.outputRms.load (std::memory_order_relaxed);
+
+    // How far the distortion has pulled the peaks down, gainToDecibels stops it going to infinity when the output is silent.
+    reading.clipAmount = juce::jmax (0.0f, juce::Decibels::gainToDecibels (reading.inputPeak)
+                                             - juce::Decibels::gainToDecibels (reading.outputPeak));
+
+    return reading;
+}
+
+//==============================================================================
+template <typename SampleType>
+void LevelMeter::measure (const juce::AudioBuffer<SampleType>& buffer, BlockLevels* levels, int numChannels) noexcept
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto [peak, sumOfSquares] = findPeakAndSumOfSquares (buffer.getReadPointer (channel), buffer.getNumSamples());
+        levels[channel] = { (float) peak, (float) sumOfSquares };
+    }
+}
+
+float LevelMeter::getDecay (int numSamples) const noexcept
+{
+    return (float) std::exp (-numSamples / (releaseSeconds * sampleRate));
+}
+
+void LevelMeter::Ballistics::update (const BlockLevels& block, int numSamples, float decay) noexcept
+{
+    // The peak jumps up straight away and falls back slowly, the mean square follows the block's average smoothly.
+    peak = juce::jmax (block.peak, peak * decay);
+
+    auto blockMeanSquare = numSamples > 0 ? block.sumOfSquares / (float) numSamples : 0.0f;
+    meanSquare = blockMeanSquare + (meanSquare - blockMeanSquare) * decay;
+
+    // Let the meters reach true silence rather than decaying into denormals.
+    if (peak < 1.0e-6f)
+        peak = 0.0f;
+
+    if (meanSquare < 1.0e-12f)
+        meanSquare = 0.0f;
+}
+
+//==============================================================================
+template void LevelMeter::measureInput<float> (const juce::AudioBuffer<float>&) noexcept;
+template void LevelMeter::measureInput<double> (const juce::AudioBuffer<double>&) noexcept;
+template void LevelMeter::measureOutput<float> (const juce::AudioBuffer<float>&) noexcept;
+template void LevelMeter::measureOutput<double> (const juce::AudioBuffer<double>&) noexcept;
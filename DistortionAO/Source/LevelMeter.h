@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    LevelMeter.h
+    Created: 17 Oct 2026 9:05:27pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Measures the input and output level of each channel, and how much the
+    distortion is taking off the peaks, for the editor's meters.
+
+    measureInput() is called before the distortion and measureOutput() after it.
+    Each one finds the block's peak and sum of squares with a SIMD reduction, a
+    single pass over each channel. The peaks then fall back and the RMS is
+    averaged over about 300ms, all once per block on the audio thread.
+
+    The results are published through relaxed atomics, one per value, which the
+    editor can read at any time from any thread without ever blocking the audio
+    thread. The values are independent, so it doesn't matter if a reading mixes
+    one block's peak with the next block's RMS.
+*/
+class LevelMeter
+{
+public:
+    /** Levels are linear gains, the clip amount is in decibels and is never negative. */
+    struct Reading
+    {
+        float inputPeak = 0.0f;
+        float inputRms = 0.0f;
+        float outputPeak = 0.0f;
+        float outputRms = 0.0f;
+        float clipAmount = 0.0f;
+    };
+
+    /** The processor only supports mono and stereo. */
+    static constexpr int maxChannels = 2;
+
+    LevelMeter() = default;
+
+    /** Sets how fast the meters fall at this sample rate and clears them, call this from prepareToPlay(). */
+    void prepare (double sampleRate, int numChannels);
+
+    /** Drops every meter back to silence. */
+    void reset() noexcept;
+
+    /** Measures the block before it is processed. */
+    template <typename SampleType>
+    void measureInput (const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    /** Measures the processed block and publishes the new readings. */
+    template <typename SampleType>
+    void measureOutput (const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    /** Lets the meters fall back over a block that was skipped because it was silent, without reading it. */
+    void measureSilence (int numSamples) noexcept;
+
+    /** The number of channels being metered. Safe to call from any thread. */
+    int getNumChannels() const noexcept                  { return numMeteredChannels.load (std::memory_order_relaxed); }
+
+    /** The latest readings for one channel. Safe to call from any thread. */
+    Reading getReading (int channel) const noexcept;
+
+private:
+    // The peak and sum of squares of one channel of one block.
+    struct BlockLevels
+    {
+        float peak = 0.0f;
+        float sumOfSquares = 0.0f;
+    };
+
+    // A meter's falling peak and averaged mean square, owned by the audio thread.
+    struct Ballistics
+    {
+        float peak = 0.0f;
+        float meanSquare = 0.0f;
+
+        void update (const BlockLevels& block, int numSamples, float decay) noexcept;
+    };
+
+    template <typename SampleType>
+    static void measure (const juce::AudioBuffer<SampleType>& buffer, BlockLevels* levels, int numChannels) noexcept;
+
+    // Runs the ballistics on the levels of the latest block and hands the results to the editor.
+    void publish (int numChannels, int numSamples) noexcept;
+
+    // Works out how much the meters fall over a block of this length.
+    float getDecay (int numSamples) const noexcept;
+
+    // Audio thread only.
+    BlockLevels inputBlock[maxChannels], outputBlock[maxChannels];
+    Ballistics inputMeters[maxChannels], outputMeters[maxChannels];
+    double sampleRate = 44100.0;
+
+    // Written by the audio thread, read by the editor.
+    struct PublishedLevels
+    {
+        std::atomic<float> inputPeak { 0.0f }, inputRms { 0.0f }, outputPeak { 0.0f }, outputRms { 0.0f };
+    };
+
+    PublishedLevels published[maxChannels];
+    std::atomic<int> numMeteredChannels { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeter)
+};
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    OversamplingStage.cpp
+    Created: 17 Oct 2026 1:47:09pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "OversamplingStage.h"
+
+//==============================================================================
+template <typename SampleType>
+void OversamplingStage<SampleType>::prepare (int numChannels, int maximumBlockSize)
+{
+    numPreparedChannels = juce::jmax (1, numChannels);
+    maxBlockSize = juce::jmax (1, maximumBlockSize);
+
+    int maxLatency = 0;
+
+    for (int type = 0; type < 2; ++type)
+    {
+        auto dspFilterType = type == iir ? juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR
+                                         : juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple;
+
+        for (int factor = 1; factor <= 3; ++factor)
+        {
+            // Integer latency adds a tiny fractional delay so the dry signal can be lined up exactly.
+            auto& oversampler = oversamplers[type][factor - 1];
+            oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>> ((size_t) numPreparedChannels, (size_t) factor, dspFilterType, true, true);
+            oversampler->initProcessing ((size_t) maxBlockSize);
+
+            maxLatency = juce::jmax (maxLatency, juce::roundToInt (oversampler->getLatencyInSamples()));
+        }
+    }
+
+    dryHistory.setSize (numPreparedChannels, maxLatency + maxBlockSize);
+    delayedDry.setSize (numPreparedChannels, maxBlockSize);
+
+    reset();
+}
+
+template <typename SampleType>
+void OversamplingStage<SampleType>::reset() noexcept
+{
+    if (auto* oversampler = getCurrentOversampler())
+        oversampler->reset();
+
+    dryHistory.clear();
+}
+
+template <typename SampleType>
+bool OversamplingStage<SampleType>::setSettings (int newFactorIndex, FilterType newFilterType) noexcept
+{
+    newFactorIndex = juce::jlimit (0, 3, newFactorIndex);
+
+    if (newFactorIndex == factorIndex && newFilterType == filterType)
+        return false;
+
+    auto oldLatency = getLatencyInSamples();
+
+    factorIndex = newFactorIndex;
+    filterType = newFilterType;
+
+    // The new filters start from silence, as does the delay for the clean signal.
+    reset();
+
+    return getLatencyInSamples() != oldLatency;
+}
+
+template <typename SampleType>
+int OversamplingStage<SampleType>::getLatencyInSamples() const noexcept
+{
+    if (auto* oversampler = getCurrentOversampler())
+        return juce::roundToInt (oversampler->getLatencyInSamples());
+
+    return 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+juce::dsp::Oversampling<SampleType>* OversamplingStage<SampleType>::getCurrentOversampler() const noexcept
+{
+    if (factorIndex == 0)
+        return nullptr;
+
+    return oversamplers[filterType][factorIndex - 1].get();
+}
+
+template <typename SampleType>
+void OversamplingStage<SampleType>::mixWithDry (SampleType* wet, const SampleType* dry, int numSamples, SampleType mix, SampleType mixStep) noexcept
+{
+    // The mix is usually still, which is the case worth doing with vector ops.
+    if (mixStep == 0)
+    {
+        juce::FloatVectorOperations::multiply (wet, mix, numSamples);
+        juce::FloatVectorOperations::addWithMultiply (wet, dry, 1 - mix, numSamples);
+        return;
+    }
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        wet[sample] = dry[sample] + mix * (wet[sample] - dry[sample]);
+        mix += mixStep;
+    }
+}
+
+template <typename SampleType>
+void OversamplingStage<SampleType>::delayDrySignal (const juce::AudioBuffer<SampleType>& buffer, int numChannels, int start, int numSamples) noexcept
+{
+    auto latency = getLatencyInSamples();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* history = dryHistory.getWritePointer (channel);
+
+        // Put the new chunk straight after the history, the first numSamples are then the delayed signal.
+        juce::FloatVectorOperations::copy (history + latency, buffer.getReadPointer (channel, start), numSamples);
+        juce::FloatVectorOperations::copy (delayedDry.getWritePointer (channel), history, numSamples);
+
+        // Keep the last latency samples as the history for the next chunk.
+        std::copy (history + numSamples, history + numSamples + latency, history);
+    }
+}
+
+//==============================================================================
+template class OversamplingStage<float>;
+template class OversamplingStage<double>;
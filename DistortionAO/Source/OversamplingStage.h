@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    OversamplingStage.h
+    Created: 17 Oct 2026 1:47:09pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Runs the distortion curve at 2x, 4x or 8x the host sample rate.
+
+    Only the nonlinearity is oversampled. The clean signal never goes through the
+    filters, instead it is delayed by the same number of samples so the dry / wet
+    mix still lines up.
+
+    Every factor and filter type is built in prepare(), so switching between them
+    while playing never allocates. The only thing that changes is the latency,
+    which the processor has to pass on to the host.
+
+    It is a template so the double precision path gets its own oversamplers
+    rather than converting every block to floats and back. Only the float and
+    double versions are compiled, in OversamplingStage.cpp.
+*/
+template <typename SampleType>
+class OversamplingStage
+{
+public:
+    /** The two polyphase half band filter designs juce::dsp::Oversampling offers. */
+    enum FilterType
+    {
+        iir = 0,        // Minimum phase, cheap, with a small amount of latency.
+        linearPhase     // Linear phase FIR, more latency but no phase shift.
+    };
+
+    OversamplingStage() = default;
+
+    /** Builds every oversampler and the dry delay, call this from prepareToPlay(). */
+    void prepare (int numChannels, int maximumBlockSize);
+
+    /** Clears the filter state and the dry delay. */
+    void reset() noexcept;
+
+    /** Picks the oversampling factor as a power of two (0 is off, 3 is 8x) and the filter type.
+        Returns true if the latency has changed.
+    */
+    bool setSettings (int newFactorIndex, FilterType newFilterType) noexcept;
+
+    /** Returns true if the stage is doing anything at all. */
+    bool isActive() const noexcept                       { return factorIndex > 0; }
+
+    /** The latency of the current settings, in samples at the host sample rate. */
+    int getLatencyInSamples() const noexcept;
+
+    /** Upsamples the buffer, calls shape() on each oversampled channel, downsamples it again
+        and then blends the result with the delayed clean signal.
+
+        The mix moves in a straight line from startMix to endMix over the buffer, so a
+        smoothed mix stays sample accurate. shape is called as
+        shape (int channel, SampleType* data, int numSamples) and should apply the curve fully wet.
+    */
+    template <typename ShapeFunction>
+    void process (juce::AudioBuffer<SampleType>& buffer, SampleType startMix, SampleType endMix, ShapeFunction&& shape) noexcept
+    {
+        process (buffer, [=] (int) { return std::make_pair (startMix, endMix); }, std::forward<ShapeFunction> (shape));
+    }
+
+    /** The same, but each channel has a mix of its own, as the mid and side do. getMixes is called as
+        getMixes (int channel) and returns a std::pair of that channel's start and end mix.
+    */
+    template <typename MixFunction, typename ShapeFunction>
+    void process (juce::AudioBuffer<SampleType>& buffer, MixFunction&& getMixes, ShapeFunction&& shape) noexcept
+    {
+        jassert (buffer.getNumChannels() <= numPreparedChannels);
+
+        auto* oversampler = getCurrentOversampler();
+
+        // Nothing to do if the stage is off or prepare() hasn't been called yet.
+        if (oversampler == nullptr)
+            return;
+
+        auto numChannels = juce::jmin (buffer.getNumChannels(), numPreparedChannels);
+
+        // The oversampler and the dry delay were only prepared for maxBlockSize samples, so a longer block goes through in pieces.
+        for (int start = 0; start < buffer.getNumSamples(); start += maxBlockSize)
+        {
+            auto numSamples = juce::jmin (maxBlockSize, buffer.getNumSamples() - start);
+
+            delayDrySignal (buffer, numChannels, start, numSamples);
+
+            juce::dsp::AudioBlock<SampleType> block (buffer.getArrayOfWritePointers(), (size_t) numChannels, (size_t) start, (size_t) numSamples);
+            auto oversampledBlock = oversampler->processSamplesUp (block);
+
+            for (size_t channel = 0; channel < oversampledBlock.getNumChannels(); ++channel)
+                shape ((int) channel, oversampledBlock.getChannelPointer (channel), (int) oversampledBlock.getNumSamples());
+
+            oversampler->processSamplesDown (block);
+
+            // Finally blend in the delayed clean signal with the correct dry / wet ratio.
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto [startMix, endMix] = getMixes (channel);
+                auto mixStep = (endMix - startMix) / (SampleType) juce::jmax (1, buffer.getNumSamples());
+
+                mixWithDry (buffer.getWritePointer (channel, start), delayedDry.getReadPointer (channel),
+                            numSamples, startMix + mixStep * (SampleType) start, mixStep);
+            }
+        }
+    }
+
+private:
+    juce::dsp::Oversampling<SampleType>* getCurrentOversampler() const noexcept;
+
+    // Blends the wet signal with the dry one, with the mix starting at mix and moving by mixStep each sample.
+    static void mixWithDry (SampleType* wet, const SampleType* dry, int numSamples, SampleType mix, SampleType mixStep) noexcept;
+
+    // Pushes a chunk of the clean signal through the delay and leaves the delayed chunk in delayedDry.
+    void delayDrySignal (const juce::AudioBuffer<SampleType>& buffer, int numChannels, int start, int numSamples) noexcept;
+
+    // One oversampler for each filter type and each factor from 2x to 8x.
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversamplers[2][3];
+
+    // Each channel holds the delay history followed by the newest chunk of the clean signal.
+    juce::AudioBuffer<SampleType> dryHistory;
+
+    // The clean signal lined up with the output of the oversampler.
+    juce::AudioBuffer<SampleType> delayedDry;
+
+    int numPreparedChannels = 0;
+    int maxBlockSize = 0;
+    int factorIndex = 0;
+    FilterType filterType = iir;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingStage)
+};
@@ -9,38 +9,85 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    // The meters sit to the right of the controls, three groups of two bars with a label under each group.
+    constexpr int meterLeft = 300;
+    constexpr int meterTop = 50;
+    constexpr int meterHeight = 180;
+    constexpr int meterBarWidth = 10;
+    constexpr int meterGroupGap = 7;
+
+    // The level meters show -60dB to 0dB, the clip meter shows up to 24dB taken off the peaks.
+    constexpr float meterFloorDecibels = -60.0f;
+    constexpr float maxClipDecibels = 24.0f;
+
+    int levelToHeight(float gain)
+    {
+        auto decibels = juce::Decibels::gainToDecibels(gain, meterFloorDecibels);
+        return juce::jlimit(0, meterHeight, juce::roundToInt(juce::jmap(decibels, meterFloorDecibels, 0.0f, 0.0f, (float) meterHeight)));
+    }
+}
+
 //==============================================================================
 DistortionAOAudioProcessorEditor::DistortionAOAudioProcessorEditor (DistortionAOAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p),
+      modeAttachment (*p.mode, disChoice),
+      thresholdAttachment (*p.threshold, thresholdSlider),
+      mixAttachment (*p.mix, mixSlider),
+      oversamplingAttachment (*p.oversampling, oversamplingChoice),
+      filterAttachment (*p.oversamplingFilter, filterChoice),
+      stereoAttachment (*p.stereo, stereoChoice),
+      sideThresholdAttachment (*p.sideThreshold, sideThresholdSlider),
+      sideMixAttachment (*p.sideMix, sideMixSlider),
+      scope (p),
+      profilerComponent (p.getProfiler(), p.getName())
 {
-    // Adds the possible items to choose from for the type of distortion.
-    disChoice.addItem("Hard Clip", 1);
-    disChoice.addItem("Soft Clip", 2);
-    disChoice.addItem("Half-Wave Rect", 3);
-    
-    // Set the default choice as 1, Hard Clip.
-    disChoice.setSelectedId(1);
-
-    // Forgot to add it to a listener so the choices weren't being chosen.
-    disChoice.addListener(this);
+    // Adds the possible items to choose from for the type of distortion, in the same order as the parameter's choices.
+    disChoice.addItemList(audioProcessor.mode->choices, 1);
+    modeAttachment.sendInitialUpdate();
     addAndMakeVisible(disChoice);
 
-    // Set up the threshold slider
-    thresholdSlider.setRange(0.0f, 1.0f, 0.001f);
-    thresholdSlider.addListener(this);
+    // The attachments give the sliders the same range as their parameters.
+    thresholdAttachment.sendInitialUpdate();
     addAndMakeVisible(thresholdSlider);
 
-    // Setup the mix slider
-    mixSlider.setRange(0.0f, 1.0f, 0.001f);
-    mixSlider.addListener(this);
+    mixAttachment.sendInitialUpdate();
     addAndMakeVisible(mixSlider);
 
-    // Define the size of the plugin.
-    setSize (300, 250);
+    // The items have to be added in the same order as the parameter's choices.
+    oversamplingChoice.addItemList(audioProcessor.oversampling->choices, 1);
+    oversamplingAttachment.sendInitialUpdate();
+    addAndMakeVisible(oversamplingChoice);
+
+    filterChoice.addItemList(audioProcessor.oversamplingFilter->choices, 1);
+    filterAttachment.sendInitialUpdate();
+    addAndMakeVisible(filterChoice);
+
+    stereoChoice.addItemList(audioProcessor.stereo->choices, 1);
+    stereoAttachment.sendInitialUpdate();
+    addAndMakeVisible(stereoChoice);
+
+    // The side's knobs only do anything in mid / side, the timer greys them out the rest of the time.
+    sideThresholdAttachment.sendInitialUpdate();
+    addAndMakeVisible(sideThresholdSlider);
+
+    sideMixAttachment.sendInitialUpdate();
+    addAndMakeVisible(sideMixSlider);
+
+    addAndMakeVisible(scope);
+    addAndMakeVisible(profilerComponent);
+
+    // Define the size of the plugin, with the meters on the right, the scope underneath and the profiler strip along the bottom.
+    setSize (380, 545 + ProfilerComponent::preferredHeight);
+
+    // Fast enough for the meters to look smooth, each tick only repaints the bars that have moved.
+    startTimerHz(30);
 }
 
 DistortionAOAudioProcessorEditor::~DistortionAOAudioProcessorEditor()
 {
+    stopTimer();
 }
 
 //==============================================================================
@@ -51,6 +98,48 @@ void DistortionAOAudioProcessorEditor::paint (juce::Graphics& g)
 
     g.setColour (juce::Colours::white);
     g.setFont (15.0f);
+
+    for (int meter = 0; meter < numMeters; ++meter)
+    {
+        auto bounds = getMeterBounds(meter);
+
+        // Most repaints only cover one or two bars, so don't draw the ones that aren't being repainted.
+        if (! g.clipRegionIntersects(bounds))
+            continue;
+
+        g.setColour(juce::Colours::darkgrey.darker());
+        g.fillRect(bounds);
+
+        auto& heights = drawnMeters[meter];
+
+        if (meter / 2 == 2)
+        {
+            // The clip meter hangs down from the top, like a compressor's gain reduction.
+            g.setColour(juce::Colours::orange);
+            g.fillRect(bounds.withHeight(heights.fill));
+        }
+        else
+        {
+            g.setColour(juce::Colours::green);
+            g.fillRect(bounds.withTop(bounds.getBottom() - heights.fill));
+
+            if (heights.peak > 0)
+            {
+                g.setColour(juce::Colours::white);
+                g.fillRect(bounds.getX(), bounds.getBottom() - heights.peak, bounds.getWidth(), 2);
+            }
+        }
+    }
+
+    // A label under each pair of bars.
+    g.setColour(juce::Colours::lightgrey);
+    g.setFont(11.0f);
+
+    const char* labels[] = { "IN", "OUT", "CLIP" };
+
+    for (int group = 0; group < 3; ++group)
+        g.drawText(labels[group], getMeterBounds(group * 2).getX() - 3, meterTop + meterHeight + 2,
+                   2 * meterBarWidth + 6, 14, juce::Justification::centred);
 }
 
 void DistortionAOAudioProcessorEditor::resized()
@@ -59,24 +148,69 @@ void DistortionAOAudioProcessorEditor::resized()
     disChoice.setBounds(50, 50, 200, 50);
     thresholdSlider.setBounds(50, 100, 200, 50);
     mixSlider.setBounds(50, 150, 200, 50);
-}
 
-void DistortionAOAudioProcessorEditor::comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged)
-{
-    // Set the menu choice to be what was selected in the combo box.
-    audioProcessor.menuChoice = comboBoxThatHasChanged->getSelectedId();
+    // The two oversampling selectors share the last row.
+    oversamplingChoice.setBounds(50, 210, 95, 30);
+    filterChoice.setBounds(155, 210, 95, 30);
+
+    // The stereo mode gets a row of its own, with the side's two sliders under it.
+    stereoChoice.setBounds(50, 250, 200, 30);
+    sideThresholdSlider.setBounds(50, 285, 200, 40);
+    sideMixSlider.setBounds(50, 330, 200, 40);
+
+    // The scope takes the full width under the controls and meters.
+    scope.setBounds(10, 380, 360, 155);
+
+    profilerComponent.setBounds(getLocalBounds().removeFromBottom(ProfilerComponent::preferredHeight));
 }
 
-void DistortionAOAudioProcessorEditor::sliderValueChanged(juce::Slider* sliderThatHasChanged)
+//==============================================================================
+void DistortionAOAudioProcessorEditor::timerCallback()
 {
-    // If it is the mix slider, pass the value back to the backend.
-    if (&mixSlider == sliderThatHasChanged)
+    // Covers the stereo mode being changed by automation or a preset as well as by the ComboBox.
+    auto isMidSide = audioProcessor.stereo->getIndex() == (int) DistortionAOAudioProcessor::StereoMode::midSide;
+    sideThresholdSlider.setEnabled(isMidSide);
+    sideMixSlider.setEnabled(isMidSide);
+
+    for (int meter = 0; meter < numMeters; ++meter)
     {
-        audioProcessor.mix = sliderThatHasChanged->getValue();
+        auto heights = getMeterHeights(meter);
+
+        // Quiet passages and silence leave most bars where they are, and then nothing is repainted at all.
+        if (heights != drawnMeters[meter])
+        {
+            drawnMeters[meter] = heights;
+            repaint(getMeterBounds(meter));
+        }
     }
-    // Else if it is the threshold slider, update the AudioProcessor's threshold value.
-    else if (&thresholdSlider == sliderThatHasChanged)
+}
+
+juce::Rectangle<int> DistortionAOAudioProcessorEditor::getMeterBounds(int meterIndex) const
+{
+    auto group = meterIndex / 2;
+    auto channel = meterIndex % 2;
+
+    return { meterLeft + group * (2 * meterBarWidth + meterGroupGap) + channel * meterBarWidth, meterTop, meterBarWidth, meterHeight };
+}
+
+DistortionAOAudioProcessorEditor::MeterHeights DistortionAOAudioProcessorEditor::getMeterHeights(int meterIndex) const
+{
+    auto& levelMeter = audioProcessor.getLevelMeter();
+    auto channel = meterIndex % 2;
+
+    // A mono layout leaves the right hand bars empty.
+    if (channel >= levelMeter.getNumChannels())
+        return {};
+
+    auto reading = levelMeter.getReading(channel);
+
+    switch (meterIndex / 2)
     {
-        audioProcessor.threshold = sliderThatHasChanged->getValue();
+        case 0:  return { levelToHeight(reading.inputRms), levelToHeight(reading.inputPeak) };
+        case 1:  return { levelToHeight(reading.outputRms), levelToHeight(reading.outputPeak) };
+        default: break;
     }
+
+    auto clip = juce::jlimit(0.0f, maxClipDecibels, reading.clipAmount);
+    return { juce::roundToInt(clip / maxClipDecibels * (float) meterHeight), 0 };
 }
@@ -10,14 +10,14 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "ScopeComponent.h"
+#include "../../Shared/ProfilerComponent.h"
 
 //==============================================================================
 /**
 */
 class DistortionAOAudioProcessorEditor  : public juce::AudioProcessorEditor,
-    // Both of these are used to listen to changes on their respective selector.
-    private juce::ComboBox::Listener,
-    private juce::Slider::Listener
+                                          private juce::Timer
 {
 public:
     DistortionAOAudioProcessorEditor (DistortionAOAudioProcessor&);
@@ -28,12 +28,24 @@ public:
     void resized() override;
 
 private:
-    // Called whenever the Combo Box changes
-    void comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged) override;
+    // The heights in pixels one meter bar is drawn at, the filled RMS (or clip) part and the peak line.
+    struct MeterHeights
+    {
+        int fill = 0;
+        int peak = 0;
+
+        bool operator!= (const MeterHeights& other) const noexcept { return fill != other.fill || peak != other.peak; }
+    };
+
+    // Input left and right, output left and right, then clip left and right.
+    static constexpr int numMeters = 6;
+
+    // Polls the processor's meters and repaints only the bars that have moved.
+    void timerCallback() override;
+
+    juce::Rectangle<int> getMeterBounds(int meterIndex) const;
+    MeterHeights getMeterHeights(int meterIndex) const;
 
-    // Called whenever one of the sliders value changes.
-    void sliderValueChanged(juce::Slider* sliderThatHasChanged) override;
-    
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     DistortionAOAudioProcessor& audioProcessor;
@@ -44,5 +56,34 @@ private:
     // Two sliders, the first the only realy DSP knob, and the second the wet versus try knob.
     juce::Slider thresholdSlider;
     juce::Slider mixSlider;
+
+    // The attachments keep the controls and the processor's parameters in sync, in both directions.
+    juce::ComboBoxParameterAttachment modeAttachment;
+    juce::SliderParameterAttachment thresholdAttachment;
+    juce::SliderParameterAttachment mixAttachment;
+
+    // Choose the oversampling factor and filter, these are attached straight to the processor's parameters.
+    juce::ComboBox oversamplingChoice;
+    juce::ComboBox filterChoice;
+    juce::ComboBoxParameterAttachment oversamplingAttachment;
+    juce::ComboBoxParameterAttachment filterAttachment;
+
+    // How a stereo pair is distorted, and the side's own threshold and mix for mid / side.
+    juce::ComboBox stereoChoice;
+    juce::Slider sideThresholdSlider;
+    juce::Slider sideMixSlider;
+    juce::ComboBoxParameterAttachment stereoAttachment;
+    juce::SliderParameterAttachment sideThresholdAttachment;
+    juce::SliderParameterAttachment sideMixAttachment;
+
+    // The transfer curve and a trace of the signal going through it.
+    ScopeComponent scope;
+
+    // Shows how much of each block's deadline processBlock is using.
+    ProfilerComponent profilerComponent;
+
+    // What each meter was last drawn at, so the timer can tell which ones need repainting.
+    MeterHeights drawnMeters[numMeters];
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DistortionAOAudioProcessorEditor)
 };
@@ -22,10 +22,41 @@ DistortionAOAudioProcessor::DistortionAOAudioProcessor()
                        )
 #endif
 {
+    // The choices are in the same order as the cases in applyDistortion and getCurveForMode.
+    // Hosts automate a choice as a 0 to 1 value, so any change to this list moves what existing automation
+    // points at. Sessions store the index instead, so reordering the list would need a migration in setStateInformation.
+    addParameter(mode = new juce::AudioParameterChoice("MODE", "Mode", { "Hard Clip", "Soft Clip", "Half-Wave Rect",
+                                                                         "Hard Clip ADAA1", "Hard Clip ADAA2",
+                                                                         "Soft Clip ADAA1", "Soft Clip ADAA2",
+                                                                         "Tanh", "Arctan", "Cubic", "Asymmetric" }, 0));
+    addParameter(threshold = new juce::AudioParameterFloat("THRESHOLD", "Threshold", 0.0f, 1.0f, 0.0f));
+    addParameter(mix = new juce::AudioParameterFloat("MIX", "Mix", 0.0f, 1.0f, 0.0f));
+
+    // Oversampling only applies to the distortion curve, the clean signal is just delayed to match.
+    addParameter(oversampling = new juce::AudioParameterChoice("OVERSAMPLING", "Oversampling", { "Off", "2x", "4x", "8x" }, 0));
+    addParameter(oversamplingFilter = new juce::AudioParameterChoice("OSFILTER", "Oversampling Filter", { "IIR", "Linear Phase" }, 0));
+
+    // Only used for stereo. In mid / side the threshold and mix above are the mid's, and the side has its own.
+    addParameter(stereo = new juce::AudioParameterChoice("STEREO", "Stereo", { "Dual Mono", "Linked", "Mid/Side" }, 0));
+    addParameter(sideThreshold = new juce::AudioParameterFloat("SIDETHRESHOLD", "Side Threshold", 0.0f, 1.0f, 0.0f));
+    addParameter(sideMix = new juce::AudioParameterFloat("SIDEMIX", "Side Mix", 0.0f, 1.0f, 0.0f));
+
+    // Built once every parameter exists, the values are worked out by parameter ID.
+    presets.setPresets({ { "Clean", {} },
+                         { "Warm Tanh", { { "MODE", 7.0f }, { "THRESHOLD", 0.3f }, { "MIX", 0.6f }, { "OVERSAMPLING", 1.0f } } },
+                         { "Hard Edge", { { "MODE", 4.0f }, { "THRESHOLD", 0.2f }, { "MIX", 1.0f } } },
+                         { "Asymmetric Drive", { { "MODE", 10.0f }, { "THRESHOLD", 0.4f }, { "MIX", 0.8f }, { "OVERSAMPLING", 2.0f } } },
+                         { "Rectified Fuzz", { { "MODE", 2.0f }, { "THRESHOLD", 0.1f }, { "MIX", 0.5f } } },
+                         { "Gritty Sides", { { "MODE", 7.0f }, { "THRESHOLD", 0.6f }, { "MIX", 0.3f },
+                                             { "STEREO", 2.0f }, { "SIDETHRESHOLD", 0.2f }, { "SIDEMIX", 0.8f } } } });
+
+    // The first two general purpose controllers move the threshold and the mix.
+    splitter.setMappings({ { 16, threshold }, { 17, mix } });
 }
 
 DistortionAOAudioProcessor::~DistortionAOAudioProcessor()
 {
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -68,39 +99,90 @@ double DistortionAOAudioProcessor::getTailLengthSeconds() const
 
 int DistortionAOAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // The bank always has at least one, some hosts don't cope very well if you tell them there are 0 programs.
+    return presets.getNumPresets();
 }
 
 int DistortionAOAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presets.getCurrentPreset();
 }
 
 void DistortionAOAudioProcessor::setCurrentProgram (int index)
 {
+    // The new values are picked up at the start of the next block.
+    presets.loadPreset(index);
 }
 
 const juce::String DistortionAOAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getPresetName(index);
 }
 
 void DistortionAOAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    // The factory presets can't be renamed.
 }
 
 //==============================================================================
 void DistortionAOAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    // The load is worked out against how long each block lasts at this rate.
+    profiler.prepare(sampleRate);
+
+    // From here on, presets wait for the start of a block.
+    presets.prepare();
+
+    const auto numChannels = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels());
+
+    // The meters fall back at the same speed whatever the sample rate.
+    levelMeter.prepare(sampleRate, numChannels);
+    scopeBuffer.prepare(sampleRate, samplesPerBlock);
+
+    // Every oversampling factor is built here so processBlock never has to allocate.
+    // The host picks the precision before preparing, so only the stage for that precision is built.
+    if (isUsingDoublePrecision())
+    {
+        doubleOversamplingStage.prepare(numChannels, samplesPerBlock);
+        doubleOversamplingStage.setSettings(oversampling->getIndex(), (OversamplingStage<double>::FilterType) oversamplingFilter->getIndex());
+        doubleOversamplingStage.reset();
+        latencyForHost = doubleOversamplingStage.getLatencyInSamples();
+    }
+    else
+    {
+        oversamplingStage.prepare(numChannels, samplesPerBlock);
+        oversamplingStage.setSettings(oversampling->getIndex(), (OversamplingStage<float>::FilterType) oversamplingFilter->getIndex());
+        oversamplingStage.reset();
+        latencyForHost = oversamplingStage.getLatencyInSamples();
+    }
+
+    adaaClipper.prepare(numChannels);
+
+    // Blocks are only skipped once the filters have had time to ring out after the input stops.
+    silenceDetector.setTailLength(latencyForHost + (int) (sampleRate * silenceTailSeconds));
+    silenceDetector.reset();
+
+    // A 20ms glide is long enough not to click and short enough to still feel immediate.
+    smoothedThreshold.prepare(sampleRate, samplesPerBlock, 0.02, ParameterSmoother<float>::Mode::linear);
+    smoothedThreshold.setCurrentAndTargetValue(threshold->get());
+
+    // The mix ramp is only ever rendered rampChunkSize samples at a time.
+    smoothedMix.prepare(sampleRate, rampChunkSize, 0.02, ParameterSmoother<float>::Mode::linear);
+    smoothedMix.setCurrentAndTargetValue(mix->get());
+
+    // The side's glide the same way, they are only ever moved a chunk or a block at a time.
+    smoothedSideThreshold.prepare(sampleRate, samplesPerBlock, 0.02, ParameterSmoother<float>::Mode::linear);
+    smoothedSideThreshold.setCurrentAndTargetValue(sideThreshold->get());
+    smoothedSideMix.prepare(sampleRate, samplesPerBlock, 0.02, ParameterSmoother<float>::Mode::linear);
+    smoothedSideMix.setCurrentAndTargetValue(sideMix->get());
+
+    setLatencySamples(latencyForHost);
 }
 
 void DistortionAOAudioProcessor::releaseResources()
 {
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
+    // There won't be any more blocks, so a preset that is still waiting is applied straight away.
+    presets.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -129,79 +211,340 @@ bool DistortionAOAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 }
 #endif
 
+// The Distortion Algorithm depends on the one choosen, which is picked once for the whole channel.
+// Each kernel applies the curve and the dry / wet mix in a single pass.
+template <typename SampleType>
+void DistortionAOAudioProcessor::applyDistortion(int choice, int channel, SampleType* channelData, int numSamples, SampleType thresholdNow, SampleType mixNow)
+{
+    switch (choice)
+    {
+    // The ADAA versions trade a little CPU for much less aliasing, without needing to oversample.
+    case 4:
+        adaaClipper.processFirstOrder<AntiderivativeClipper::HardClip>(channel, channelData, numSamples, thresholdNow, mixNow);
+        break;
+    case 5:
+        adaaClipper.processSecondOrder<AntiderivativeClipper::HardClip>(channel, channelData, numSamples, thresholdNow, mixNow);
+        break;
+    case 6:
+        adaaClipper.processFirstOrder<AntiderivativeClipper::SoftClip>(channel, channelData, numSamples, thresholdNow, mixNow);
+        break;
+    case 7:
+        adaaClipper.processSecondOrder<AntiderivativeClipper::SoftClip>(channel, channelData, numSamples, thresholdNow, mixNow);
+        break;
+    default:
+        // Every other mode is one of the waveshaper curves, which all share the same block kernel.
+        DistortionKernels::process(getCurveForMode(choice - 1), channelData, numSamples, thresholdNow, mixNow);
+        break;
+    }
+}
+
+DistortionKernels::CurveType DistortionAOAudioProcessor::getCurveForMode(int modeIndex)
+{
+    using CurveType = DistortionKernels::CurveType;
+
+    // In the same order as the mode parameter's choices, the ADAA modes follow the same curves as the plain clippers.
+    static constexpr CurveType curves[] = { CurveType::hardClip, CurveType::softClip, CurveType::halfWaveRectifier,
+                                            CurveType::hardClip, CurveType::hardClip, CurveType::softClip, CurveType::softClip,
+                                            CurveType::tanh, CurveType::arctan, CurveType::cubic, CurveType::asymmetric };
+
+    return curves[juce::jlimit(0, (int) std::size(curves) - 1, modeIndex)];
+}
+
 void DistortionAOAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    BlockProfiler::ScopedTimer timer(profiler, buffer.getNumSamples());
+
+    // Flushes denormals to zero for the rest of the block, the filters and curves would otherwise slow right down as a tail fades out.
+    juce::ScopedNoDenormals noDenormals;
+
+    presets.applyPendingValues();
+
+    // An idle track's block is only cleared, and the meters and scope fall back without reading it.
+    if (skipSilentBlock(buffer))
+    {
+        // Nothing is processed, but the controllers in the block still take effect.
+        splitter.applyAll(midiMessages);
+
+        levelMeter.measureSilence(buffer.getNumSamples());
+        scopeBuffer.addSilence(buffer.getNumSamples());
+        return;
+    }
+
+    levelMeter.measureInput(buffer);
+    scopeBuffer.addInput(buffer);
+
+    // A MIDI controller can move the threshold or mix part way through, so each part between them is processed on its own.
+    splitter.process(buffer, midiMessages, [this](auto& subBlock) { processSamples(subBlock); });
+
+    levelMeter.measureOutput(buffer);
+    scopeBuffer.addOutput(buffer);
+}
+
+void DistortionAOAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // The same steps as the float version above, skipSilentBlock() and processSamples() pick the double stages.
+    BlockProfiler::ScopedTimer timer(profiler, buffer.getNumSamples());
+
+    juce::ScopedNoDenormals noDenormals;
+
+    presets.applyPendingValues();
+
+    if (skipSilentBlock(buffer))
+    {
+        splitter.applyAll(midiMessages);
+
+        levelMeter.measureSilence(buffer.getNumSamples());
+        scopeBuffer.addSilence(buffer.getNumSamples());
+        return;
+    }
+
+    levelMeter.measureInput(buffer);
+    scopeBuffer.addInput(buffer);
+
+    splitter.process(buffer, midiMessages, [this](auto& subBlock) { processSamples(subBlock); });
+
+    levelMeter.measureOutput(buffer);
+    scopeBuffer.addOutput(buffer);
+}
+
+bool DistortionAOAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+OversamplingStage<SampleType>& DistortionAOAudioProcessor::getOversamplingStage() noexcept
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return doubleOversamplingStage;
+    else
+        return oversamplingStage;
+}
+
+template <typename SampleType>
+bool DistortionAOAudioProcessor::skipSilentBlock(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& stage = getOversamplingStage<SampleType>();
+
+    // Switching the oversampling is free, but the host has to be told about the new latency.
+    if (stage.setSettings(oversampling->getIndex(), (typename OversamplingStage<SampleType>::FilterType) oversamplingFilter->getIndex()))
+    {
+        latencyForHost = stage.getLatencyInSamples();
+        silenceDetector.setTailLength(latencyForHost + (int) (getSampleRate() * silenceTailSeconds));
+        triggerAsyncUpdate();
+    }
+
+    if (silenceDetector.process(buffer))
+    {
+        // Whatever is left in the filters has died away by now, so it is cleared to exact zeros
+        // rather than being left to creep down through the denormals.
+        if (silenceDetector.hasJustStartedSkipping())
+        {
+            stage.reset();
+            adaaClipper.reset();
+        }
+
+        // Every curve turns silence into silence, so there is nothing to ramp and the settings can jump to their targets.
+        // That leaves nothing moving, and the block after the silence starts from settled state.
+        smoothedThreshold.setCurrentAndTargetValue(threshold->get());
+        smoothedMix.setCurrentAndTargetValue(mix->get());
+        smoothedSideThreshold.setCurrentAndTargetValue(sideThreshold->get());
+        smoothedSideMix.setCurrentAndTargetValue(sideMix->get());
+
+        buffer.clear();
+        return true;
+    }
+
+    return false;
+}
+
+template <typename SampleType>
+void DistortionAOAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& stage = getOversamplingStage<SampleType>();
+
+    // Read the parameters once so the whole block is processed with the same settings.
+    // The menu's IDs start at 1, the parameter's index starts at 0.
+    const auto choice = mode->getIndex() + 1;
+    smoothedThreshold.setTargetValue(threshold->get());
+    smoothedMix.setTargetValue(mix->get());
+    smoothedSideThreshold.setTargetValue(sideThreshold->get());
+    smoothedSideMix.setTargetValue(sideMix->get());
+
+    // A mono track has no pair to link or encode, so it is always processed on its own.
+    const auto stereoMode = buffer.getNumChannels() == 2 ? static_cast<StereoMode>(stereo->getIndex()) : StereoMode::dualMono;
+
+    // The side's settings only apply to mid / side, the rest of the time they just keep up with their targets.
+    if (stereoMode != StereoMode::midSide)
+    {
+        smoothedSideThreshold.skip(buffer.getNumSamples());
+        smoothedSideMix.skip(buffer.getNumSamples());
+    }
+
+    if (stage.isActive())
+    {
+        // The threshold only moves once per block here, the stage ramps the mix itself.
+        const auto startMix = (SampleType) smoothedMix.getCurrentValue();
+        const auto endMix = (SampleType) smoothedMix.skip(buffer.getNumSamples());
+        const auto currentThreshold = (SampleType) smoothedThreshold.skip(buffer.getNumSamples());
+
+        if (stereoMode == StereoMode::midSide)
+        {
+            // The oversamplers' filters sit between the encode and the curve, so here they are a pass either side of the stage.
+            const std::pair<SampleType, SampleType> mixes[] = { { startMix, endMix },
+                                                                { (SampleType) smoothedSideMix.getCurrentValue(),
+                                                                  (SampleType) smoothedSideMix.skip(buffer.getNumSamples()) } };
+            const SampleType thresholds[] = { currentThreshold, (SampleType) smoothedSideThreshold.skip(buffer.getNumSamples()) };
+
+            DistortionKernels::encodeMidSide(buffer.getWritePointer(0), buffer.getWritePointer(1), buffer.getNumSamples());
+
+            stage.process(buffer, [&](int channel) { return mixes[channel]; }, [&](int channel, SampleType* data, int numSamples)
+            {
+                applyDistortion(choice, channel, data, numSamples, thresholds[channel], (SampleType) 1);
+            });
+
+            DistortionKernels::decodeMidSide(buffer.getWritePointer(0), buffer.getWritePointer(1), buffer.getNumSamples());
+            return;
+        }
+
+        // Only the curve runs at the higher rate, fully wet, and the stage mixes in the delayed clean signal afterwards.
+        // Linked needs both channels at once, which the oversamplers don't give, so it is dual mono here.
+        stage.process(buffer, startMix, endMix, [&](int channel, SampleType* data, int numSamples)
+        {
+            applyDistortion(choice, channel, data, numSamples, currentThreshold, (SampleType) 1);
+        });
+
+        return;
+    }
+
+    if (stereoMode != StereoMode::dualMono)
+    {
+        processStereo(buffer, choice, stereoMode);
+        return;
+    }
+
+    if (smoothedThreshold.isSmoothing() || smoothedMix.isSmoothing())
+    {
+        processRamping(buffer, choice);
+        return;
+    }
+
+    // Nothing is moving, so every channel gets the same settings in a single pass.
+    const auto currentThreshold = (SampleType) smoothedThreshold.getCurrentValue();
+    const auto currentMix = (SampleType) smoothedMix.getCurrentValue();
+
     // Loop through each of the channels
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
-        // Each time create a Write Pointer to that channel's buffe.
-        auto* channelData = buffer.getWritePointer(channel);
+        // Each time create a Write Pointer to that channel's buffer.
+        applyDistortion(choice, channel, buffer.getWritePointer(channel), buffer.getNumSamples(), currentThreshold, currentMix);
+    }
+}
+
+template <typename SampleType>
+void DistortionAOAudioProcessor::processRamping(juce::AudioBuffer<SampleType>& buffer, int choice)
+{
+    // The mix is ramped per sample, the threshold changes the curve itself so it moves once per chunk.
+    SampleType dry[rampChunkSize];
+    SampleType convertedRamp[rampChunkSize];
 
-        // Loop through all the samples.
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+    for (int start = 0; start < buffer.getNumSamples(); start += rampChunkSize)
+    {
+        auto numSamples = juce::jmin(rampChunkSize, buffer.getNumSamples() - start);
+
+        // The smoothers work in floats, so the double path converts the ramp once per chunk for every channel to share.
+        const SampleType* mixRamp = nullptr;
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            mixRamp = smoothedMix.renderRamp(numSamples);
+        }
+        else
         {
-            // For use in the distortion
-            auto input = channelData[sample];
+            auto* floatRamp = smoothedMix.renderRamp(numSamples);
+
+            for (int sample = 0; sample < numSamples; ++sample)
+                convertedRamp[sample] = (SampleType) floatRamp[sample];
+
+            mixRamp = convertedRamp;
+        }
+
+        const auto currentThreshold = (SampleType) smoothedThreshold.skip(numSamples);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* channelData = buffer.getWritePointer(channel, start);
+
+            // Run the curve fully wet, then blend: out = dry + mix * (wet - dry).
+            juce::FloatVectorOperations::copy(dry, channelData, numSamples);
+            applyDistortion(choice, channel, channelData, numSamples, currentThreshold, (SampleType) 1);
+
+            juce::FloatVectorOperations::subtract(channelData, dry, numSamples);
+            juce::FloatVectorOperations::multiply(channelData, mixRamp, numSamples);
+            juce::FloatVectorOperations::add(channelData, dry, numSamples);
+        }
+    }
+}
+
+template <typename SampleType>
+void DistortionAOAudioProcessor::processStereo(juce::AudioBuffer<SampleType>& buffer, int choice, StereoMode stereoMode)
+{
+    auto* left = buffer.getWritePointer(0);
+    auto* right = buffer.getWritePointer(1);
+
+    // While anything is gliding, every setting moves once per chunk, the mix included. Otherwise the whole block is one chunk.
+    const auto isRamping = smoothedThreshold.isSmoothing() || smoothedMix.isSmoothing()
+                        || smoothedSideThreshold.isSmoothing() || smoothedSideMix.isSmoothing();
+    const auto chunkSize = isRamping ? rampChunkSize : buffer.getNumSamples();
 
-            // A clean sample that is not touched by the distortion algorithm.
-            auto cleanOut = channelData[sample];
+    for (int start = 0; start < buffer.getNumSamples(); start += chunkSize)
+    {
+        auto numSamples = juce::jmin(chunkSize, buffer.getNumSamples() - start);
 
-            // The Distortion Algorithm depends on the one choosen.
-            switch (menuChoice)
+        const auto midThreshold = (SampleType) smoothedThreshold.skip(numSamples);
+        const auto midMix = (SampleType) smoothedMix.skip(numSamples);
+
+        if (stereoMode == StereoMode::linked)
+        {
+            if (usesAntiderivativeClipper(choice))
             {
-            // Hard Clipping
-            // Hard Clipping clips the sample's value to the threshold when its absolute value is greater than the threshold.
-            case 1:
-                if (input > threshold)
-                {
-                    input = threshold;
-                }
-                else if (input < -threshold)
-                {
-                    input = -threshold;
-                }
-                else
-                {
-                    input = input;
-                }
-                break;
-            // Soft Clipping Exp
-            // Similar to Hard Clipping except its input is slightly pushed away with the expf function.
-            case 2:
-                if (input > threshold)
-                {
-                    input = 1.0f - expf(-input);
-                }
-                else if (input < -threshold)
-                {
-                    input = -1.0f + expf(input);
-                }
-                else
-                {
-                    input = input;
-                }
-                break;
-            // Half-Wave Rectifier
-            // Only keeps half the waveform, or in other words anything above threshold is kept, but nothing below it.
-            case 3:
-                if (input > threshold)
-                {
-                    input = input;
-                }
-                else
-                    input = 0;
-                break;
-            default:
-                // If not a valid choice, we have some kind of error.
-                jassertfalse;
-                    
+                // The ADAA clippers follow each channel's own history, so they can only run dual mono.
+                applyDistortion(choice, 0, left + start, numSamples, midThreshold, midMix);
+                applyDistortion(choice, 1, right + start, numSamples, midThreshold, midMix);
             }
-            // Finally return the sample to channelData with the correct dry / wet ratio
-            channelData[sample] = ((1 - mix) * cleanOut) + (mix * input);
+            else
+            {
+                DistortionKernels::processLinked(getCurveForMode(choice - 1), left + start, right + start, numSamples, midThreshold, midMix);
+            }
+
+            continue;
+        }
+
+        const auto sideThresholdNow = (SampleType) smoothedSideThreshold.skip(numSamples);
+        const auto sideMixNow = (SampleType) smoothedSideMix.skip(numSamples);
+
+        if (usesAntiderivativeClipper(choice))
+        {
+            // The clippers still get the mid and the side as their two channels, with an encode and a decode pass either side.
+            DistortionKernels::encodeMidSide(left + start, right + start, numSamples);
+            applyDistortion(choice, 0, left + start, numSamples, midThreshold, midMix);
+            applyDistortion(choice, 1, right + start, numSamples, sideThresholdNow, sideMixNow);
+            DistortionKernels::decodeMidSide(left + start, right + start, numSamples);
+        }
+        else
+        {
+            // The encode, both curves and the decode in a single pass over the pair.
+            DistortionKernels::processMidSide(getCurveForMode(choice - 1), left + start, right + start, numSamples,
+                                              midThreshold, midMix, sideThresholdNow, sideMixNow);
         }
     }
 }
 
+void DistortionAOAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(latencyForHost);
+}
+
 //==============================================================================
 bool DistortionAOAudioProcessor::hasEditor() const
 {
@@ -216,15 +559,14 @@ juce::AudioProcessorEditor* DistortionAOAudioProcessor::createEditor()
 //==============================================================================
 void DistortionAOAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    // Every parameter by ID with its real value, and the preset that was loaded.
+    presets.saveState(stateVersion, destData);
 }
 
 void DistortionAOAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    // Sessions saved before there was any state are empty, and leave the current settings alone.
+    presets.restoreState(data, sizeInBytes, stateVersion);
 }
 
 //==============================================================================
@@ -9,6 +9,16 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "OversamplingStage.h"
+#include "AntiderivativeClipper.h"
+#include "DistortionKernels.h"
+#include "LevelMeter.h"
+#include "ScopeBuffer.h"
+#include "../../Shared/ParameterSmoother.h"
+#include "../../Shared/BlockProfiler.h"
+#include "../../Shared/PresetBank.h"
+#include "../../Shared/SilenceDetector.h"
+#include "../../Shared/BlockSplitter.h"
 
 //==============================================================================
 /**
@@ -17,6 +27,7 @@ class DistortionAOAudioProcessor  : public juce::AudioProcessor
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
+                             , private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -32,6 +43,10 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    // Every stage has a double version, so 64 bit hosts don't have to convert each block to floats.
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -56,11 +71,114 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    // The only three values that are responsible for the Distortion Effects Algorithm
-    int menuChoice{ 1 };
-    float threshold{ 0.0f };
-    float mix{ 0.0f };
+    // How long each processBlock call takes, for the editor to show.
+    BlockProfiler& getProfiler() noexcept { return profiler; }
+
+    // The input, output and clip levels, for the editor's meters.
+    const LevelMeter& getLevelMeter() const noexcept { return levelMeter; }
+
+    // The decimated input and output, for the editor's scope. Only the scope should read from it.
+    ScopeBuffer& getScopeBuffer() noexcept { return scopeBuffer; }
+
+    // The waveshaper curve a mode uses, the ADAA modes map to the curve they smooth out.
+    static DistortionKernels::CurveType getCurveForMode(int modeIndex);
+
+    // The only three values that are responsible for the Distortion Effects Algorithm.
+    // They are parameters so the editor and the host can both change them without racing the audio thread.
+    juce::AudioParameterChoice* mode;
+    juce::AudioParameterFloat* threshold;
+    juce::AudioParameterFloat* mix;
+
+    // How much the distortion is oversampled by and which filters are used to do it.
+    juce::AudioParameterChoice* oversampling;
+    juce::AudioParameterChoice* oversamplingFilter;
+
+    // How a stereo pair is distorted, in the same order as the stereo parameter's choices.
+    enum class StereoMode
+    {
+        dualMono = 0,   // Each channel on its own.
+        linked,         // Both channels turned down together by whichever is louder.
+        midSide         // The mid and side each with their own threshold and mix.
+    };
+
+    // The threshold and mix above are the mid's in mid / side, these are the side's.
+    juce::AudioParameterChoice* stereo;
+    juce::AudioParameterFloat* sideThreshold;
+    juce::AudioParameterFloat* sideMix;
 private:
+    // Passes a new latency on to the host from the message thread.
+    void handleAsyncUpdate() override;
+
+    // Picks up a new oversampling setting, then clears the block and returns true if the input is silent and the filters have rung out.
+    template <typename SampleType>
+    bool skipSilentBlock(juce::AudioBuffer<SampleType>& buffer);
+
+    // Distorts one part of the block between controllers, for either precision.
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // Runs the curve picked in the menu over one channel, blended with the clean signal.
+    template <typename SampleType>
+    void applyDistortion(int choice, int channel, SampleType* channelData, int numSamples, SampleType thresholdNow, SampleType mixNow);
+
+    // Used while the threshold or mix is ramping, works through the buffer a few samples at a time.
+    template <typename SampleType>
+    void processRamping(juce::AudioBuffer<SampleType>& buffer, int choice);
+
+    // The stereo linked and mid / side modes without oversampling, both channels in one pass.
+    template <typename SampleType>
+    void processStereo(juce::AudioBuffer<SampleType>& buffer, int choice, StereoMode stereoMode);
+
+    // The ADAA modes keep state for each channel, so they can't be linked or fused into the mid / side pass.
+    static bool usesAntiderivativeClipper(int choice) noexcept { return choice >= 4 && choice <= 7; }
+
+    // The oversampling stage for whichever precision the host is using.
+    template <typename SampleType>
+    OversamplingStage<SampleType>& getOversamplingStage() noexcept;
+
+    // Short enough that the threshold steps are inaudible, long enough for the kernels to still use SIMD.
+    static constexpr int rampChunkSize = 32;
+
+    // Oversamples the distortion curve when it is switched on. Only the one for the current precision is prepared.
+    OversamplingStage<float> oversamplingStage;
+    OversamplingStage<double> doubleOversamplingStage;
+
+    // The anti-aliased clippers keep the last couple of samples of each channel.
+    AntiderivativeClipper adaaClipper;
+
+    // Skips the whole block once the input and the filters' tail are silent.
+    SilenceDetector silenceDetector;
+
+    // How long the oversampling filters are given to ring on past their latency before blocks are skipped.
+    static constexpr double silenceTailSeconds = 0.05;
+
+    // Cuts each block wherever a MIDI controller moves a parameter, so the change lands on the right sample.
+    BlockSplitter splitter;
+
+    // The latency the audio thread wants the host to know about. The oversampling stages belong to the audio thread,
+    // so this is the only part of them handleAsyncUpdate() ever reads on the message thread.
+    std::atomic<int> latencyForHost{ 0 };
+
+    // The threshold and mix glide to new values instead of jumping, which would click.
+    ParameterSmoother<float> smoothedThreshold;
+    ParameterSmoother<float> smoothedMix;
+    ParameterSmoother<float> smoothedSideThreshold;
+    ParameterSmoother<float> smoothedSideMix;
+
+    // Times every processBlock call without locking or allocating on the audio thread.
+    BlockProfiler profiler;
+
+    // The factory presets. Presets and restored sessions are applied all at once at the start of a block.
+    PresetBank presets { *this };
+
+    // Bump this, and pass a migration to restoreState(), when a change needs more than new parameters getting their defaults.
+    static constexpr int stateVersion = 1;
+
+    // Measures the levels either side of the distortion, also without locking.
+    LevelMeter levelMeter;
+
+    // Hands the scope a min / max outline of the signal either side of the distortion.
+    ScopeBuffer scopeBuffer;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DistortionAOAudioProcessor)
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    ScopeBuffer.cpp
+    Created: 17 Oct 2026 9:41:12pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "ScopeBuffer.h"
+
+//==============================================================================
+void ScopeBuffer::prepare (double sampleRate, int maximumBlockSize)
+{
+    samplesPerPoint = juce::jmax (1, juce::roundToInt (sampleRate / pointsPerSecond));
+
+    // One more than the block can finish, in case the unfinished point from the last block is completed too.
+    auto maxPointsPerBlock = (size_t) (juce::jmax (1, maximumBlockSize) / samplesPerPoint + 1);
+    inputPoints.resize (maxPointsPerBlock);
+    outputPoints.resize (maxPointsPerBlock);
+
+    reset();
+}
+
+void ScopeBuffer::reset() noexcept
+{
+    fifo.reset();
+    inputPartial = outputPartial = {};
+    samplesInPartial = 0;
+}
+
+template <typename SampleType>
+void ScopeBuffer::addInput (const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    decimate (buffer, inputPoints.data(), inputPartial);
+}
+
+template <typename SampleType>
+void ScopeBuffer::addOutput (const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    auto numFinished = decimate (buffer, outputPoints.data(), outputPartial);
+
+    // Both calls split the block in the same places, so the unfinished point only moves on once they are done.
+    samplesInPartial = (samplesInPartial + buffer.getNumSamples()) % samplesPerPoint;
+
+    pushPoints (numFinished);
+}
+
+void ScopeBuffer::addSilence (int numSamples) noexcept
+{
+    auto numPointsEnded = (samplesInPartial + numSamples) / samplesPerPoint;
+    auto numFinished = juce::jmin (numPointsEnded, (int) inputPoints.size());
+    const juce::Range<float> silence;
+
+    for (int i = 0; i < numFinished; ++i)
+    {
+        // The first point finishes off whatever the last block left unfinished, the rest are flat.
+        auto continuesPartial = i == 0 && samplesInPartial > 0;
+        inputPoints[(size_t) i] = continuesPartial ? inputPartial.getUnionWith (silence) : silence;
+        outputPoints[(size_t) i] = continuesPartial ? outputPartial.getUnionWith (silence) : silence;
+    }
+
+    if (numPointsEnded == 0 && samplesInPartial > 0)
+    {
+        inputPartial = inputPartial.getUnionWith (silence);
+        outputPartial = outputPartial.getUnionWith (silence);
+    }
+    else
+    {
+        inputPartial = outputPartial = silence;
+    }
+
+    samplesInPartial = (samplesInPartial + numSamples) % samplesPerPoint;
+
+    pushPoints (numFinished);
+}
+
+void ScopeBuffer::pushPoints (int numFinished) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numFinished, start1, size1, start2, size2);
+
+    // Anything that doesn't fit is dropped, the editor is either closed or has fallen behind.
+    for (int i = 0; i < size1; ++i)
+        points[(size_t) (start1 + i)] = { inputPoints[(size_t) i], outputPoints[(size_t) i] };
+
+    for (int i = 0; i < size2; ++i)
+        points[(size_t) (start2 + i)] = { inputPoints[(size_t) (size1 + i)], outputPoints[(size_t) (size1 + i)] };
+
+    fifo.finishedWrite (size1 + size2);
+}
+
+int ScopeBuffer::readPoints (Point* dest, int maxPoints) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (juce::jmin (maxPoints, fifo.getNumReady()), start1, size1, start2, size2);
+
+    std::copy_n (points.begin() + start1, size1, dest);
+    std::copy_n (points.begin() + start2, size2, dest + size1);
+
+    fifo.finishedRead (size1 + size2);
+    return size1 + size2;
+}
+
+//==============================================================================
+template <typename SampleType>
+int ScopeBuffer::decimate (const juce::AudioBuffer<SampleType>& buffer, juce::Range<float>* finished, juce::Range<float>& partial) const noexcept
+{
+    auto numSamples = buffer.getNumSamples();
+    auto maxPoints = (int) inputPoints.size();
+    auto filled = samplesInPartial;
+    int numFinished = 0;
+
+    for (int start = 0; start < numSamples;)
+    {
+        auto length = juce::jmin (samplesPerPoint - filled, numSamples - start);
+
+        // findMinMax is vectorised, so each point costs one short SIMD pass per channel.
+        juce::Range<float> range;
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto channelRange = buffer.findMinMax (channel, start, length);
+            juce::Range<float> asFloat ((float) channelRange.getStart(), (float) channelRange.getEnd());
+            range = channel == 0 ? asFloat : range.getUnionWith (asFloat);
+        }
+
+        partial = filled == 0 ? range : partial.getUnionWith (range);
+        filled += length;
+        start += length;
+
+        if (filled == samplesPerPoint)
+        {
+            // A block bigger than the one prepared for only loses its last few points.
+            if (numFinished < maxPoints)
+                finished[numFinished++] = partial;
+
+            filled = 0;
+        }
+    }
+
+    return numFinished;
+}
+
+//==============================================================================
+template void ScopeBuffer::addInput<float> (const juce::AudioBuffer<float>&) noexcept;
+template void ScopeBuffer::addInput<double> (const juce::AudioBuffer<double>&) noexcept;
+template void ScopeBuffer::addOutput<float> (const juce::AudioBuffer<float>&) noexcept;
+template void ScopeBuffer::addOutput<double> (const juce::AudioBuffer<double>&) noexcept;
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    ScopeBuffer.h
+    Created: 17 Oct 2026 9:41:12pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Carries a decimated copy of the input and output from the audio thread to the
+    editor's scope.
+
+    The audio thread squashes every samplesPerPoint samples down to the minimum
+    and maximum of the input and the output, across all channels, so the editor
+    only has to draw about a thousand points a second whatever the sample rate.
+    A point can be split across two blocks, the unfinished one is carried over.
+
+    The points go through a single producer, single consumer juce::AbstractFifo,
+    so neither side ever waits for the other. When the editor is closed nobody
+    reads the FIFO, it fills up and the new points are simply dropped.
+*/
+class ScopeBuffer
+{
+public:
+    /** The range the input and output covered over one point's worth of samples. */
+    struct Point
+    {
+        juce::Range<float> input;
+        juce::Range<float> output;
+    };
+
+    /** About a millisecond per point, so a couple of hundred pixels of trace show a couple of hundred milliseconds. */
+    static constexpr double pointsPerSecond = 1000.0;
+
+    ScopeBuffer() = default;
+
+    /** Works out how many samples go into each point and allocates room for a block's worth, call this from prepareToPlay(). */
+    void prepare (double sampleRate, int maximumBlockSize);
+
+    /** Throws away any points that haven't been read and the unfinished one. Only call this while the audio thread isn't processing. */
+    void reset() noexcept;
+
+    /** Decimates the block before it is processed. */
+    template <typename SampleType>
+    void addInput (const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    /** Decimates the processed block and pushes the finished points into the FIFO. */
+    template <typename SampleType>
+    void addOutput (const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    /** Adds a block that was skipped because it was silent, so the trace keeps scrolling without the block being read. */
+    void addSilence (int numSamples) noexcept;
+
+    /** Copies up to maxPoints of the oldest unread points into dest and returns how many there were. Editor only. */
+    int readPoints (Point* dest, int maxPoints) noexcept;
+
+private:
+    // Splits the block into points, continuing the unfinished one. Returns how many points were finished.
+    template <typename SampleType>
+    int decimate (const juce::AudioBuffer<SampleType>& buffer, juce::Range<float>* finished, juce::Range<float>& partial) const noexcept;
+
+    // Hands the points finished in this block over to the editor.
+    void pushPoints (int numFinished) noexcept;
+
+    //==============================================================================
+    // A couple of seconds of points, so the editor can miss a few frames without losing any.
+    static constexpr int fifoSize = 2048;
+    juce::AbstractFifo fifo { fifoSize };
+    std::array<Point, (size_t) fifoSize> points;
+
+    // Audio thread only. The input and output points finished in this block, and the ones still being filled.
+    std::vector<juce::Range<float>> inputPoints, outputPoints;
+    juce::Range<float> inputPartial, outputPartial;
+    int samplesPerPoint = 44;
+    int samplesInPartial = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScopeBuffer)
+};
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    ScopeComponent.cpp
+    Created: 17 Oct 2026 9:52:40pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "ScopeComponent.h"
+
+namespace
+{
+    // Both axes run from -1 to 1, the curves never go past that at any threshold.
+    float toScreenX (juce::Rectangle<int> area, float value)
+    {
+        return (float) area.getX() + (juce::jlimit (-1.0f, 1.0f, value) + 1.0f) * 0.5f * (float) area.getWidth();
+    }
+
+    float toScreenY (juce::Rectangle<int> area, float value)
+    {
+        return (float) area.getBottom() - (juce::jlimit (-1.0f, 1.0f, value) + 1.0f) * 0.5f * (float) area.getHeight();
+    }
+}
+
+//==============================================================================
+ScopeComponent::ScopeComponent (DistortionAOAudioProcessor& processorToShow)
+    : processor (processorToShow)
+{
+    setOpaque (true);
+
+    // The trace scrolls, so it needs a steady frame rate to look smooth.
+    startTimerHz (60);
+}
+
+ScopeComponent::~ScopeComponent()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void ScopeComponent::paint (juce::Graphics& g)
+{
+    g.fillAll (juce::Colours::black);
+
+    auto curveArea = getCurveArea();
+    g.drawImageAt (curveImage, curveArea.getX(), curveArea.getY());
+
+    auto& latest = history[(size_t) ((historyWriteIndex + historySize - 1) % historySize)];
+
+    // Where the last millisecond of signal reached on the curve, its lowest and highest points.
+    g.setColour (juce::Colours::orange);
+    g.fillRect (toScreenX (curveArea, latest.input.getStart()) - 2.0f, toScreenY (curveArea, latest.output.getStart()) - 2.0f, 4.0f, 4.0f);
+    g.fillRect (toScreenX (curveArea, latest.input.getEnd()) - 2.0f, toScreenY (curveArea, latest.output.getEnd()) - 2.0f, 4.0f, 4.0f);
+
+    // One min / max line per pixel, newest on the right. The output is drawn over the input so the clipped part shows in grey.
+    auto traceArea = getTraceArea();
+    auto numColumns = juce::jmin (traceArea.getWidth(), historySize);
+
+    g.setColour (juce::Colours::darkgrey.darker());
+    g.fillRect (traceArea);
+
+    for (int column = 0; column < numColumns; ++column)
+    {
+        auto& point = history[(size_t) ((historyWriteIndex + historySize - numColumns + column) % historySize)];
+        auto x = traceArea.getX() + column;
+
+        g.setColour (juce::Colours::grey);
+        g.drawVerticalLine (x, toScreenY (traceArea, point.input.getEnd()), toScreenY (traceArea, point.input.getStart()) + 1.0f);
+
+        g.setColour (juce::Colours::limegreen);
+        g.drawVerticalLine (x, toScreenY (traceArea, point.output.getEnd()), toScreenY (traceArea, point.output.getStart()) + 1.0f);
+    }
+}
+
+void ScopeComponent::resized()
+{
+    // The image has to match the new size, so force it to be drawn again.
+    renderedSettings = {};
+    renderCurve();
+}
+
+//==============================================================================
+void ScopeComponent::timerCallback()
+{
+    auto settings = getCurrentSettings();
+    auto changed = false;
+
+    if (settings != renderedSettings)
+    {
+        renderCurve();
+        changed = true;
+    }
+
+    // Read everything that has arrived, the ring only ever keeps the newest historySize points.
+    for (;;)
+    {
+        auto numRead = processor.getScopeBuffer().readPoints (history.data() + historyWriteIndex, historySize - historyWriteIndex);
+
+        if (numRead == 0)
+            break;
+
+        historyWriteIndex = (historyWriteIndex + numRead) % historySize;
+        changed = true;
+    }
+
+    // Nothing to scroll and the curve is the same, so the frame would look exactly like the last one.
+    if (changed)
+        repaint();
+}
+
+ScopeComponent::CurveSettings ScopeComponent::getCurrentSettings() const
+{
+    return { processor.mode->getIndex(), processor.threshold->get(), processor.mix->get() };
+}
+
+void ScopeComponent::renderCurve()
+{
+    auto area = getCurveArea();
+
+    if (area.isEmpty())
+        return;
+
+    renderedSettings = getCurrentSettings();
+
+    curveImage = juce::Image (juce::Image::ARGB, area.getWidth(), area.getHeight(), true);
+    juce::Graphics g (curveImage);
+
+    auto bounds = curveImage.getBounds();
+
+    g.setColour (juce::Colours::darkgrey.darker());
+    g.fillRect (bounds);
+
+    // The axes, and the straight line the clean signal would follow.
+    g.setColour (juce::Colours::darkgrey);
+    g.drawHorizontalLine (bounds.getCentreY(), 0.0f, (float) bounds.getWidth());
+    g.drawVerticalLine (bounds.getCentreX(), 0.0f, (float) bounds.getHeight());
+    g.drawLine (0.0f, (float) bounds.getHeight(), (float) bounds.getWidth(), 0.0f);
+
+    // Runs a ramp from -1 to 1 through the same kernels as the audio, so the curve is exactly what is heard.
+    // The ADAA modes draw the curves they smooth out, they only differ in how they handle aliasing.
+    std::vector<float> curve ((size_t) bounds.getWidth());
+
+    for (size_t i = 0; i < curve.size(); ++i)
+        curve[i] = juce::jmap ((float) i, 0.0f, (float) juce::jmax (1, bounds.getWidth() - 1), -1.0f, 1.0f);
+
+    auto* data = curve.data();
+    auto numPoints = (int) curve.size();
+
+    DistortionKernels::process (DistortionAOAudioProcessor::getCurveForMode (renderedSettings.mode), data, numPoints,
+                                renderedSettings.threshold, renderedSettings.mix);
+
+    juce::Path path;
+    path.preallocateSpace (numPoints * 3);
+    path.startNewSubPath (0.0f, toScreenY (bounds, curve[0]));
+
+    for (int i = 1; i < numPoints; ++i)
+        path.lineTo ((float) i, toScreenY (bounds, curve[(size_t) i]));
+
+    g.setColour (juce::Colours::white);
+    g.strokePath (path, juce::PathStrokeType (1.5f));
+}
+
+juce::Rectangle<int> ScopeComponent::getCurveArea() const
+{
+    auto area = getLocalBounds().reduced (4);
+    return area.removeFromLeft (area.getHeight());
+}
+
+juce::Rectangle<int> ScopeComponent::getTraceArea() const
+{
+    auto area = getLocalBounds().reduced (4);
+    area.removeFromLeft (area.getHeight() + 6);
+    return area;
+}
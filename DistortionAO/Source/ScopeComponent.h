@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    ScopeComponent.h
+    Created: 17 Oct 2026 9:52:40pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+    Shows the distortion's transfer curve on the left, with where the signal
+    currently sits on it, and a scrolling trace of the input and output on the
+    right.
+
+    The curve only changes when the mode, threshold or mix does, so it is drawn
+    once into an Image and every frame just blits it. The trace is a fixed number
+    of min / max lines, one per pixel, so each frame costs the same whatever is
+    playing.
+*/
+class ScopeComponent  : public juce::Component,
+                        private juce::Timer
+{
+public:
+    ScopeComponent (DistortionAOAudioProcessor& processorToShow);
+    ~ScopeComponent() override;
+
+    //==============================================================================
+    void paint (juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    // Everything the curve depends on, so the timer can tell when it has to be drawn again.
+    struct CurveSettings
+    {
+        int mode = -1;
+        float threshold = 0.0f;
+        float mix = 0.0f;
+
+        bool operator!= (const CurveSettings& other) const noexcept
+        {
+            return mode != other.mode || threshold != other.threshold || mix != other.mix;
+        }
+    };
+
+    void timerCallback() override;
+
+    CurveSettings getCurrentSettings() const;
+    void renderCurve();
+
+    // The curve is a square on the left, the trace fills the rest.
+    juce::Rectangle<int> getCurveArea() const;
+    juce::Rectangle<int> getTraceArea() const;
+
+    //==============================================================================
+    DistortionAOAudioProcessor& processor;
+
+    // The curve as it was last drawn, and what it was drawn with.
+    juce::Image curveImage;
+    CurveSettings renderedSettings;
+
+    // The points read from the processor, a ring that is at least as long as the trace is wide.
+    static constexpr int historySize = 1024;
+    std::array<ScopeBuffer::Point, (size_t) historySize> history {};
+    int historyWriteIndex = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScopeComponent)
+};
@@ -0,0 +1,395 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 18 Oct 2026 12:21:47am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+#include "../../Shared/PluginRegistry.h"
+
+namespace BatchRenderer
+{
+    namespace
+    {
+        // A few seconds of audio per file, so a worker only waits on the disk when it is that far ahead of it.
+        constexpr int writeBufferSamples = 1 << 18;
+
+        //==============================================================================
+        // One queue of files per worker. The owner takes from the front, where the largest files are,
+        // and a worker with nothing left takes from the back of someone else's, where the smallest are.
+        // Each file is taken once, so the locks are only ever held for a push or a pop.
+        class WorkQueues
+        {
+        public:
+            explicit WorkQueues(int numWorkers)
+                : queues((size_t) numWorkers)
+            {
+            }
+
+            void add(int worker, int job)
+            {
+                auto& queue = queues[(size_t) worker];
+                const juce::SpinLock::ScopedLockType lock(queue.lock);
+                queue.jobs.push_back(job);
+            }
+
+            // Returns the next file for this worker, or -1 once every queue is empty.
+            int next(int worker, bool& stolen)
+            {
+                {
+                    auto& own = queues[(size_t) worker];
+                    const juce::SpinLock::ScopedLockType lock(own.lock);
+
+                    if (! own.jobs.empty())
+                    {
+                        auto job = own.jobs.front();
+                        own.jobs.pop_front();
+                        stolen = false;
+                        return job;
+                    }
+                }
+
+                for (size_t i = 1; i < queues.size(); ++i)
+                {
+                    auto& other = queues[((size_t) worker + i) % queues.size()];
+                    const juce::SpinLock::ScopedLockType lock(other.lock);
+
+                    if (! other.jobs.empty())
+                    {
+                        auto job = other.jobs.back();
+                        other.jobs.pop_back();
+                        stolen = true;
+                        return job;
+                    }
+                }
+
+                return -1;
+            }
+
+        private:
+            struct Queue
+            {
+                juce::SpinLock lock;
+                std::deque<int> jobs;
+            };
+
+            std::vector<Queue> queues;
+        };
+
+        //==============================================================================
+        // WAV and AIFF are mapped straight into memory, anything else is read through a stream.
+        std::unique_ptr<juce::AudioFormatReader> openInput(juce::AudioFormatManager& formatManager, const juce::File& file)
+        {
+            if (auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+            {
+                std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+                if (mapped != nullptr && mapped->mapEntireFile())
+                    return mapped;
+            }
+
+            return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+        }
+
+        std::unique_ptr<juce::AudioFormatWriter> createOutput(const juce::File& file, double sampleRate, int numChannels,
+                                                              int bitsPerSample, juce::String& error)
+        {
+            file.deleteFile();
+            auto stream = file.createOutputStream();
+
+            if (stream == nullptr)
+            {
+                error = "couldn't write to " + file.getFullPathName();
+                return {};
+            }
+
+            juce::WavAudioFormat wavFormat;
+            std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), sampleRate, (unsigned int) numChannels,
+                                                                                      bitsPerSample, {}, 0));
+
+            if (writer == nullptr)
+            {
+                error = "the WAV writer can't do " + juce::String(numChannels) + " channels at " + juce::String(bitsPerSample) + " bits";
+                return {};
+            }
+
+            // The writer owns the stream now.
+            stream.release();
+            return writer;
+        }
+
+        //==============================================================================
+        class Worker  : public juce::Thread
+        {
+        public:
+            Worker(int workerIndex, std::unique_ptr<juce::AudioProcessor> processorToUse, const Options& optionsToUse,
+                   WorkQueues& queuesToUse, juce::TimeSliceThread& writeThreadToUse, std::vector<FileResult>& resultsToFill)
+                : juce::Thread("Batch worker " + juce::String(workerIndex)),
+                  index(workerIndex), processor(std::move(processorToUse)), options(optionsToUse),
+                  queues(queuesToUse), writeThread(writeThreadToUse), results(resultsToFill)
+            {
+                formatManager.registerBasicFormats();
+            }
+
+            void run() override
+            {
+                auto stolen = false;
+
+                for (auto job = queues.next(index, stolen); job >= 0 && ! threadShouldExit(); job = queues.next(index, stolen))
+                {
+                    // Only this worker ever touches this result, and nobody reads it until every worker has finished.
+                    auto& result = results[(size_t) job];
+                    result.worker = index;
+                    result.stolen = stolen;
+
+                    render(result);
+                }
+            }
+
+        private:
+            void render(FileResult& result)
+            {
+                auto reader = openInput(formatManager, result.input);
+
+                if (reader == nullptr)
+                {
+                    result.error = "couldn't open it as an audio file";
+                    return;
+                }
+
+                // Prepared from scratch for every file, so nothing is carried over from the one before.
+                // A layout the processor can't take leaves it on its default one.
+                const auto sampleRate = reader->sampleRate;
+                PluginRegistry::setChannelLayout(*processor, (int) reader->numChannels);
+
+                processor->setNonRealtime(true);
+                processor->setRateAndBufferSizeDetails(sampleRate, options.blockSize);
+                processor->prepareToPlay(sampleRate, options.blockSize);
+
+                const auto latency = processor->getLatencySamples();
+                const auto numChannels = juce::jmax(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels());
+                const auto numOutputChannels = processor->getTotalNumOutputChannels();
+                const auto bitsPerSample = options.bitsPerSample > 0 ? options.bitsPerSample : (int) reader->bitsPerSample;
+
+                auto writer = createOutput(result.output, sampleRate, numOutputChannels, bitsPerSample, result.error);
+
+                if (writer == nullptr)
+                {
+                    processor->releaseResources();
+                    return;
+                }
+
+                buffer.setSize(numChannels, options.blockSize, false, false, true);
+                outputChannels.resize((size_t) numOutputChannels);
+
+                juce::int64 processTicks = 0;
+
+                {
+                    // Blocks are copied into the writer's buffer and written to disk on the write thread.
+                    juce::AudioFormatWriter::ThreadedWriter threadedWriter(writer.release(), writeThread,
+                                                                           juce::jmax(writeBufferSamples, options.blockSize * 4));
+
+                    // Run past the end of the file by the latency so the output comes out the same length as the input.
+                    const auto totalSamples = reader->lengthInSamples + latency;
+
+                    for (juce::int64 position = 0; position < totalSamples && ! threadShouldExit();)
+                    {
+                        auto numSamples = (int) juce::jmin((juce::int64) options.blockSize, totalSamples - position);
+                        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+                        block.clear();
+                        reader->read(&block, 0, numSamples, position, true, true);
+                        midiMessages.clear();
+
+                        auto blockStart = juce::Time::getHighResolutionTicks();
+                        processor->processBlock(block, midiMessages);
+                        processTicks += juce::Time::getHighResolutionTicks() - blockStart;
+
+                        // Drop the first latency samples, which are just the processor's delay.
+                        auto skip = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, latency - position);
+
+                        if (skip < numSamples)
+                        {
+                            for (int channel = 0; channel < numOutputChannels; ++channel)
+                                outputChannels[(size_t) channel] = block.getReadPointer(channel, skip);
+
+                            // The buffer only fills up if the disk falls behind, so wait for it rather than drop anything.
+                            while (! threadedWriter.write(outputChannels.data(), numSamples - skip))
+                                juce::Thread::sleep(1);
+                        }
+
+                        position += numSamples;
+                    }
+
+                    // Going out of scope writes whatever is still buffered and closes the file.
+                }
+
+                processor->releaseResources();
+
+                result.audioSeconds = (double) reader->lengthInSamples / sampleRate;
+                result.processSeconds = juce::Time::highResolutionTicksToSeconds(processTicks);
+            }
+
+            const int index;
+            std::unique_ptr<juce::AudioProcessor> processor;
+            const Options& options;
+            WorkQueues& queues;
+            juce::TimeSliceThread& writeThread;
+            std::vector<FileResult>& results;
+
+            // Each worker has its own, so nothing is shared while reading.
+            juce::AudioFormatManager formatManager;
+            juce::AudioBuffer<float> buffer;
+            juce::MidiBuffer midiMessages;
+            std::vector<const float*> outputChannels;
+        };
+
+        //==============================================================================
+        void printReport(const Options& options, const std::vector<FileResult>& results, int numWorkers, double wallSeconds)
+        {
+            std::cout << "file                            worker  audio s  process s  x realtime" << std::endl;
+
+            double totalAudio = 0.0;
+            std::vector<double> busySeconds((size_t) numWorkers);
+            std::vector<int> numFiles((size_t) numWorkers), numStolen((size_t) numWorkers);
+            int numFailed = 0;
+
+            for (auto& result : results)
+            {
+                if (result.error.isNotEmpty())
+                {
+                    std::cout << result.input.getFileName().paddedRight(' ', 32) << "FAILED, " << result.error << std::endl;
+                    ++numFailed;
+                    continue;
+                }
+
+                std::cout << result.input.getFileName().paddedRight(' ', 32)
+                          << (juce::String(result.worker) + (result.stolen ? "*" : "")).paddedLeft(' ', 6)
+                          << juce::String(result.audioSeconds, 2).paddedLeft(' ', 9)
+                          << juce::String(result.processSeconds, 3).paddedLeft(' ', 11)
+                          << juce::String(result.audioSeconds / juce::jmax(result.processSeconds, 1.0e-9), 1).paddedLeft(' ', 12) << std::endl;
+
+                totalAudio += result.audioSeconds;
+                busySeconds[(size_t) result.worker] += result.processSeconds;
+                numFiles[(size_t) result.worker]++;
+                numStolen[(size_t) result.worker] += result.stolen ? 1 : 0;
+            }
+
+            std::cout << std::endl << "* taken from another worker's queue" << std::endl << std::endl;
+
+            for (int worker = 0; worker < numWorkers; ++worker)
+                std::cout << "worker " << worker << ": " << numFiles[(size_t) worker] << " files, " << numStolen[(size_t) worker]
+                          << " taken, processBlock busy " << juce::String(busySeconds[(size_t) worker], 3) << " s" << std::endl;
+
+            // Comparing this line across --threads values shows how well the batch scales.
+            std::cout << std::endl << options.plugin << ": " << juce::String(totalAudio, 2) << " s of audio in "
+                      << juce::String(wallSeconds, 3) << " s on " << numWorkers << " workers, "
+                      << juce::String(totalAudio / juce::jmax(wallSeconds, 1.0e-9), 1) << "x realtime";
+
+            if (numFailed > 0)
+                std::cout << ", " << numFailed << " failed";
+
+            std::cout << std::endl;
+        }
+    }
+
+    //==============================================================================
+    std::vector<juce::File> findInputs(const juce::File& folder)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::vector<juce::File> inputs;
+
+        for (auto& file : folder.findChildFiles(juce::File::findFiles, false, formatManager.getWildcardForAllFormats()))
+            inputs.push_back(file);
+
+        // Files compare by their full paths.
+        std::sort(inputs.begin(), inputs.end());
+
+        return inputs;
+    }
+
+    std::vector<FileResult> run(const Options& options)
+    {
+        std::vector<FileResult> results(options.inputs.size());
+        std::vector<int> jobs;
+
+        for (size_t i = 0; i < options.inputs.size(); ++i)
+        {
+            auto& result = results[i];
+            result.input = options.inputs[i];
+            result.output = options.outputFolder.getChildFile(result.input.getFileNameWithoutExtension() + ".wav");
+
+            // Two inputs with the same name would write over each other, so only the first one is rendered.
+            for (size_t j = 0; j < i; ++j)
+                if (results[j].output == result.output)
+                    result.error = "has the same name as " + results[j].input.getFullPathName();
+
+            if (result.error.isEmpty())
+                jobs.push_back((int) i);
+        }
+
+        if (jobs.empty())
+            return results;
+
+        const auto numWorkers = juce::jlimit(1, (int) jobs.size(),
+                                             options.numThreads > 0 ? options.numThreads : juce::SystemStats::getNumCpus());
+
+        // Dealt out largest first, so the long files start straight away and the short ones are left to even out the end.
+        std::stable_sort(jobs.begin(), jobs.end(), [&](int a, int b)
+        {
+            return options.inputs[(size_t) a].getSize() > options.inputs[(size_t) b].getSize();
+        });
+
+        WorkQueues queues(numWorkers);
+
+        for (size_t i = 0; i < jobs.size(); ++i)
+            queues.add((int) (i % (size_t) numWorkers), jobs[i]);
+
+        // One write thread is plenty, the workers only hand it blocks to encode.
+        juce::TimeSliceThread writeThread("Batch writer");
+        writeThread.startThread();
+
+        // The processors are made and set up here, so the registry is only ever used from one thread.
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            auto processor = PluginRegistry::createPlugin(options.plugin);
+
+            if (processor == nullptr)
+            {
+                for (auto job : jobs)
+                    results[(size_t) job].error = "there is no plugin called " + options.plugin;
+
+                return results;
+            }
+
+            for (auto& [parameterID, value] : options.parameters)
+                PluginRegistry::setParameter(*processor, parameterID, value);
+
+            workers.push_back(std::make_unique<Worker>(i, std::move(processor), options, queues, writeThread, results));
+        }
+
+        auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (auto& worker : workers)
+            worker->startThread();
+
+        for (auto& worker : workers)
+            worker->waitForThreadToExit(-1);
+
+        auto wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+        workers.clear();
+        writeThread.stopThread(1000);
+
+        printReport(options, results, numWorkers, wallSeconds);
+        return results;
+    }
+}
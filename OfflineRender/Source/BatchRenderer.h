@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 18 Oct 2026 12:21:47am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Runs one of the tutorial processors over a whole folder of files, using every
+    core.
+
+    Each worker thread has its own processor, prepared again for every file, so
+    a file comes out the same whichever worker renders it and however many there
+    are. The files are dealt out largest first, and a worker that runs out takes
+    the smallest file left in another worker's queue, so one long file doesn't
+    leave the other cores idle at the end.
+
+    Inputs are memory mapped where the format allows it, so reading is just page
+    faults rather than copies through a stream. Writing goes through a buffered
+    ThreadedWriter, so the workers never wait for the disk. The results are
+    reported in the order of the inputs, whichever order they finish in.
+*/
+namespace BatchRenderer
+{
+    /** What to render and how. */
+    struct Options
+    {
+        juce::String plugin;
+
+        // Set on every processor by ID, each with the parameter's own range.
+        std::vector<std::pair<juce::String, float>> parameters;
+
+        // The files to render, in the order they are reported in.
+        std::vector<juce::File> inputs;
+
+        // Each output is a WAV file in here with the same name as its input.
+        juce::File outputFolder;
+
+        int blockSize = 512;
+
+        // 0 keeps each input's own bit depth.
+        int bitsPerSample = 0;
+
+        // 0 uses one worker per core.
+        int numThreads = 0;
+    };
+
+    /** How one file went. */
+    struct FileResult
+    {
+        juce::File input, output;
+        juce::String error;
+        int worker = -1;
+        bool stolen = false;
+
+        double audioSeconds = 0.0;
+        double processSeconds = 0.0;
+    };
+
+    /** Finds every audio file the format manager can read in a folder, sorted by path so the order never changes. */
+    std::vector<juce::File> findInputs (const juce::File& folder);
+
+    /** Renders every input and returns one result per input, in the same order. */
+    std::vector<FileResult> run (const Options& options);
+}
@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Shared/PluginRegistry.h"
+#include "BatchRenderer.h"
+
+namespace
+{
+    constexpr int defaultBlockSize = 512;
+
+    void printUsage()
+    {
+        std::cout << "Usage: OfflineRender --plugin <name> --input <file> --output <file>" << std::endl
+                  << "                     [--block <samples>] [--bits <depth>] [--param <ID>=<value> ...]" << std::endl
+                  << "       OfflineRender --plugin <name> --batch <folder> --output <folder>" << std::endl
+                  << "                     [--threads <count>] [--block <samples>] [--bits <depth>] [--param <ID>=<value> ...]" << std::endl
+                  << "       OfflineRender --list" << std::endl << std::endl
+                  << "Runs one of the tutorial processors over a WAV or AIFF file, block by block," << std::endl
+                  << "and writes the result with the processor's latency removed." << std::endl << std::endl
+                  << "With --batch every audio file in the folder is rendered to a WAV file of the same name," << std::endl
+                  << "on one worker per core unless --threads says otherwise." << std::endl;
+    }
+
+    // Prints every plugin along with the parameters that can be set with --param.
+    void printPlugins()
+    {
+        for (auto& name : PluginRegistry::getPluginNames())
+        {
+            std::cout << name << std::endl;
+
+            if (auto processor = PluginRegistry::createPlugin(name))
+                for (auto& line : PluginRegistry::describeParameters(*processor))
+                    std::cout << "    " << line << std::endl;
+
+            std::cout << std::endl;
+        }
+    }
+
+    // Collects every --param ID=value pair, in the order they were given.
+    bool collectParameters(const juce::ArgumentList& args, std::vector<std::pair<juce::String, float>>& parameters)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            if (! (args[i] == "--param"))
+                continue;
+
+            auto setting = i + 1 < args.size() ? args[i + 1].text : juce::String();
+            auto parameterID = setting.upToFirstOccurrenceOf("=", false, false).trim();
+            auto value = setting.fromFirstOccurrenceOf("=", false, false).trim();
+
+            if (parameterID.isEmpty() || value.isEmpty())
+            {
+                std::cerr << "Expected --param <ID>=<value>, got \"" << setting << "\"" << std::endl;
+                return false;
+            }
+
+            parameters.push_back({ parameterID, value.getFloatValue() });
+        }
+
+        return true;
+    }
+
+    bool applyParameters(const std::vector<std::pair<juce::String, float>>& parameters, juce::AudioProcessor& processor)
+    {
+        for (auto& [parameterID, value] : parameters)
+        {
+            if (! PluginRegistry::setParameter(processor, parameterID, value))
+            {
+                std::cerr << processor.getName() << " has no parameter called " << parameterID
+                          << ", use --list to see them all" << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Asks for the same number of channels as the file, or leaves the processor's own layout if it can't do that.
+    void matchChannelLayout(juce::AudioProcessor& processor, int numFileChannels)
+    {
+        if (! PluginRegistry::setChannelLayout(processor, numFileChannels))
+            std::cout << processor.getName() << " can't take " << numFileChannels << " channels, using its default layout" << std::endl;
+    }
+
+    // Renders every audio file in a folder across all the cores. Each worker gets its own processor,
+    // the one made in main() is only used to check the parameters first.
+    int renderBatch(const juce::ArgumentList& args, juce::AudioProcessor& processor, int blockSize,
+                    const std::vector<std::pair<juce::String, float>>& parameters)
+    {
+        if (! applyParameters(parameters, processor))
+            return 1;
+
+        auto inputFolder = args.getFileForOption("--batch");
+
+        if (! inputFolder.isDirectory())
+        {
+            std::cerr << inputFolder.getFullPathName() << " isn't a folder" << std::endl;
+            return 1;
+        }
+
+        BatchRenderer::Options options;
+        options.plugin = args.getValueForOption("--plugin");
+        options.parameters = parameters;
+        options.inputs = BatchRenderer::findInputs(inputFolder);
+        options.outputFolder = args.getFileForOption("--output");
+        options.blockSize = blockSize;
+        options.bitsPerSample = args.containsOption("--bits") ? args.getValueForOption("--bits").getIntValue() : 0;
+        options.numThreads = args.containsOption("--threads") ? args.getValueForOption("--threads").getIntValue() : 0;
+
+        if (options.inputs.empty())
+        {
+            std::cerr << "There are no audio files in " << inputFolder.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        if (auto created = options.outputFolder.createDirectory(); created.failed())
+        {
+            std::cerr << "Couldn't create " << options.outputFolder.getFullPathName() << ": " << created.getErrorMessage() << std::endl;
+            return 1;
+        }
+
+        auto results = BatchRenderer::run(options);
+
+        auto allRendered = std::all_of(results.begin(), results.end(), [](const BatchRenderer::FileResult& result)
+        {
+            return result.error.isEmpty();
+        });
+
+        return allRendered ? 0 : 1;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    // Some of the processors post messages, so they need a message manager even without a window.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    if (args.containsOption("--list"))
+    {
+        printPlugins();
+        return 0;
+    }
+
+    if (! args.containsOption("--plugin") || ! args.containsOption("--output")
+         || (! args.containsOption("--input") && ! args.containsOption("--batch")))
+    {
+        printUsage();
+        return 1;
+    }
+
+    auto processor = PluginRegistry::createPlugin(args.getValueForOption("--plugin"));
+
+    if (processor == nullptr)
+    {
+        std::cerr << "Unknown plugin " << args.getValueForOption("--plugin") << ", expected one of "
+                  << PluginRegistry::getPluginNames().joinIntoString(", ") << std::endl;
+        return 1;
+    }
+
+    const auto blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : defaultBlockSize;
+
+    if (blockSize <= 0)
+    {
+        std::cerr << "The block size has to be at least one sample" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::pair<juce::String, float>> parameters;
+
+    if (! collectParameters(args, parameters))
+        return 1;
+
+    if (args.containsOption("--batch"))
+        return renderBatch(args, *processor, blockSize, parameters);
+
+    //==============================================================================
+    // The input is streamed from disk a block at a time, so files of any length only need one block of memory.
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto inputFile = args.getFileForOption("--input");
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(inputFile));
+
+    if (reader == nullptr)
+    {
+        std::cerr << "Couldn't open " << inputFile.getFullPathName() << " as an audio file" << std::endl;
+        return 1;
+    }
+
+    const auto sampleRate = reader->sampleRate;
+
+    matchChannelLayout(*processor, (int) reader->numChannels);
+
+    if (! applyParameters(parameters, *processor))
+        return 1;
+
+    processor->setNonRealtime(true);
+    processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor->prepareToPlay(sampleRate, blockSize);
+
+    // The latency is only known once the processor has been prepared.
+    const auto latency = processor->getLatencySamples();
+    const auto numChannels = juce::jmax(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels());
+    const auto numOutputChannels = processor->getTotalNumOutputChannels();
+
+    //==============================================================================
+    auto outputFile = args.getFileForOption("--output");
+    auto* outputFormat = formatManager.findFormatForFileExtension(outputFile.getFileExtension());
+
+    if (outputFormat == nullptr)
+    {
+        std::cerr << "Don't know how to write " << outputFile.getFileExtension() << " files, use .wav or .aiff" << std::endl;
+        return 1;
+    }
+
+    outputFile.deleteFile();
+    auto outputStream = outputFile.createOutputStream();
+
+    if (outputStream == nullptr)
+    {
+        std::cerr << "Couldn't write to " << outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    const auto bitsPerSample = args.containsOption("--bits") ? args.getValueForOption("--bits").getIntValue() : (int) reader->bitsPerSample;
+    std::unique_ptr<juce::AudioFormatWriter> writer(outputFormat->createWriterFor(outputStream.get(), sampleRate, (unsigned int) numOutputChannels,
+                                                                                  bitsPerSample, {}, 0));
+
+    if (writer == nullptr)
+    {
+        std::cerr << "The " << outputFormat->getFormatName() << " writer can't do " << numOutputChannels << " channels at "
+                  << bitsPerSample << " bits" << std::endl;
+        return 1;
+    }
+
+    // The writer owns the stream now.
+    outputStream.release();
+
+    //==============================================================================
+    // Run past the end of the file by the latency so the output comes out the same length as the input.
+    // The reader fills anything past the end with silence.
+    const auto totalSamples = reader->lengthInSamples + latency;
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::MidiBuffer midiMessages;
+
+    juce::int64 position = 0;
+    juce::int64 processTicks = 0;
+    auto startTicks = juce::Time::getHighResolutionTicks();
+
+    while (position < totalSamples)
+    {
+        auto numSamples = (int) juce::jmin((juce::int64) blockSize, totalSamples - position);
+
+        // A view of the first numSamples of the buffer, so the last block can be shorter without reallocating.
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+        block.clear();
+        reader->read(&block, 0, numSamples, position, true, true);
+        midiMessages.clear();
+
+        auto blockStart = juce::Time::getHighResolutionTicks();
+        processor->processBlock(block, midiMessages);
+        processTicks += juce::Time::getHighResolutionTicks() - blockStart;
+
+        // Drop the first latency samples, which are just the processor's delay.
+        auto skip = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, latency - position);
+
+        if (skip < numSamples)
+            writer->writeFromAudioSampleBuffer(block, skip, numSamples - skip);
+
+        position += numSamples;
+    }
+
+    writer.reset();
+    processor->releaseResources();
+
+    //==============================================================================
+    const auto audioSeconds = (double) reader->lengthInSamples / sampleRate;
+    const auto processSeconds = juce::Time::highResolutionTicksToSeconds(processTicks);
+    const auto totalSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+    std::cout << processor->getName() << ": " << inputFile.getFileName() << " -> " << outputFile.getFileName() << std::endl
+              << "  " << juce::String(audioSeconds, 2) << " s of audio, " << numChannels << " channels at " << sampleRate
+              << " Hz, " << blockSize << " sample blocks, " << latency << " samples latency" << std::endl
+              << "  processBlock " << juce::String(processSeconds, 3) << " s, "
+              << juce::String(audioSeconds / juce::jmax(processSeconds, 1.0e-9), 1) << "x realtime" << std::endl
+              << "  with file i/o " << juce::String(totalSeconds, 3) << " s, "
+              << juce::String(audioSeconds / juce::jmax(totalSeconds, 1.0e-9), 1) << "x realtime" << std::endl;
+
+    return 0;
+}
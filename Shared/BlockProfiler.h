@@ -0,0 +1,265 @@
+/*
+  ==============================================================================
+
+    BlockProfiler.h
+    Created: 17 Oct 2026 8:14:36pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Times every processBlock call inside a live host and reports how much of the
+    block's deadline it used.
+
+    The audio thread only reads the clock twice and writes one entry into a
+    lock-free single producer, single consumer FIFO (juce::AbstractFifo). Nothing
+    on that side allocates or locks. If the FIFO is full the entry is dropped and
+    counted, the audio thread never waits.
+
+    A timer on the message thread drains the FIFO ten times a second. It works out
+    the load of each block, keeps the last historySize blocks, and updates the
+    min / average / 99th percentile / max. It can also write every block to a CSV
+    file. The load is the time spent in processBlock as a percentage of the time
+    the block lasts, so 100% means the plugin only just kept up.
+
+    The clock is juce::Time::getHighResolutionTicks(), which is a steady clock on
+    every platform and is already in seconds, unlike the time stamp counter.
+*/
+class BlockProfiler  : private juce::Timer
+{
+public:
+    /** The load figures over the last historySize blocks, as percentages of the deadline. */
+    struct Stats
+    {
+        float minimum = 0.0f;
+        float average = 0.0f;
+        float p99 = 0.0f;
+        float maximum = 0.0f;
+
+        // How many blocks the figures are from, and how many were lost because the FIFO was full.
+        int numBlocks = 0;
+        int numDropped = 0;
+    };
+
+    //==============================================================================
+    /** Times from where it is created to the end of the scope, put one at the top of processBlock. */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer (BlockProfiler& profilerToUse, int numSamplesInBlock) noexcept
+            : profiler (profilerToUse), numSamples (numSamplesInBlock), startTicks (juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~ScopedTimer() noexcept
+        {
+            profiler.push (startTicks, juce::Time::getHighResolutionTicks() - startTicks, numSamples);
+        }
+
+    private:
+        BlockProfiler& profiler;
+        const int numSamples;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+    };
+
+    //==============================================================================
+    BlockProfiler()
+    {
+        loads.resize ((size_t) historySize);
+        sortedLoads.reserve ((size_t) historySize);
+
+        startTimerHz (10);
+    }
+
+    ~BlockProfiler() override
+    {
+        stopTimer();
+    }
+
+    /** Sets the sample rate the deadlines are worked out from and starts the figures again, call this from prepareToPlay(). */
+    void prepare (double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    /** Forgets every block timed so far. The history belongs to the message thread, so this only asks for it
+        to be cleared, and the next update() does it. Safe to call from any thread.
+    */
+    void reset() noexcept
+    {
+        resetPending = true;
+    }
+
+    /** Adds one block's timing, this is what ScopedTimer calls. Safe to call from the audio thread. */
+    void push (juce::int64 startTicks, juce::int64 elapsedTicks, int numSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (1, start1, size1, start2, size2);
+
+        if (size1 + size2 < 1)
+        {
+            numDropped.fetch_add (1, std::memory_order_relaxed);
+            return;
+        }
+
+        entries[(size_t) (size1 > 0 ? start1 : start2)] = { startTicks, elapsedTicks, numSamples };
+        fifo.finishedWrite (1);
+    }
+
+    //==============================================================================
+    /** The latest figures. Message thread only. */
+    const Stats& getStats() const noexcept              { return stats; }
+
+    /** Starts writing every block to a CSV file, replacing anything already in it. Message thread only. */
+    bool startDump (const juce::File& file)
+    {
+        stopDump();
+
+        file.deleteFile();
+        auto stream = std::make_unique<juce::FileOutputStream> (file);
+
+        if (! stream->openedOk())
+            return false;
+
+        *stream << "time_s,samples,elapsed_us,load_percent\n";
+        dumpStream = std::move (stream);
+        return true;
+    }
+
+    /** Stops writing to the CSV file and closes it. Message thread only. */
+    void stopDump()
+    {
+        if (dumpStream != nullptr)
+            dumpStream->flush();
+
+        dumpStream.reset();
+    }
+
+    bool isDumping() const noexcept                     { return dumpStream != nullptr; }
+
+    /** Empties the FIFO and updates the figures. The timer calls this, but a host without a message loop can call it directly. */
+    void update()
+    {
+        auto discard = resetPending.exchange (false);
+
+        if (discard)
+        {
+            numDropped = 0;
+            numInHistory = 0;
+            writeIndex = 0;
+            stats = {};
+        }
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+            return;
+
+        // After a reset, whatever is waiting is read out and thrown away. Only the reading side of the FIFO ever moves here.
+        if (! discard)
+        {
+            for (int i = 0; i < size1; ++i)
+                addToHistory (entries[(size_t) (start1 + i)]);
+
+            for (int i = 0; i < size2; ++i)
+                addToHistory (entries[(size_t) (start2 + i)]);
+        }
+
+        fifo.finishedRead (size1 + size2);
+
+        updateStats();
+    }
+
+    /** How many blocks the figures are taken from. */
+    static constexpr int historySize = 2048;
+
+private:
+    // One processBlock call, in high resolution ticks.
+    struct Entry
+    {
+        juce::int64 startTicks = 0;
+        juce::int64 elapsedTicks = 0;
+        int numSamples = 0;
+    };
+
+    void timerCallback() override
+    {
+        update();
+    }
+
+    void addToHistory (const Entry& entry)
+    {
+        auto rate = sampleRate.load();
+
+        if (entry.numSamples <= 0 || rate <= 0.0)
+            return;
+
+        auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds (entry.elapsedTicks);
+        auto deadlineSeconds = entry.numSamples / rate;
+        auto load = (float) (100.0 * elapsedSeconds / deadlineSeconds);
+
+        loads[(size_t) writeIndex] = load;
+        writeIndex = (writeIndex + 1) % historySize;
+        numInHistory = juce::jmin (numInHistory + 1, historySize);
+
+        if (dumpStream != nullptr)
+            *dumpStream << juce::String (juce::Time::highResolutionTicksToSeconds (entry.startTicks), 6) << ","
+                        << entry.numSamples << ","
+                        << juce::String (elapsedSeconds * 1.0e6, 2) << ","
+                        << juce::String (load, 3) << "\n";
+    }
+
+    void updateStats()
+    {
+        Stats newStats;
+        newStats.numBlocks = numInHistory;
+        newStats.numDropped = numDropped.load (std::memory_order_relaxed);
+
+        if (numInHistory > 0)
+        {
+            // The history is a ring, but the figures don't care about the order so the first numInHistory are used as they are.
+            sortedLoads.assign (loads.begin(), loads.begin() + numInHistory);
+
+            auto p99Index = (size_t) juce::jmin (numInHistory - 1, (numInHistory * 99) / 100);
+            std::nth_element (sortedLoads.begin(), sortedLoads.begin() + (std::ptrdiff_t) p99Index, sortedLoads.end());
+            newStats.p99 = sortedLoads[p99Index];
+
+            auto [smallest, largest] = std::minmax_element (sortedLoads.begin(), sortedLoads.end());
+            newStats.minimum = *smallest;
+            newStats.maximum = *largest;
+            newStats.average = std::accumulate (sortedLoads.begin(), sortedLoads.end(), 0.0f) / (float) numInHistory;
+        }
+
+        stats = newStats;
+    }
+
+    //==============================================================================
+    // Audio thread to message thread. A second of 32 sample blocks at 96kHz fits with room to spare.
+    static constexpr int fifoSize = 4096;
+    juce::AbstractFifo fifo { fifoSize };
+    std::array<Entry, (size_t) fifoSize> entries;
+    std::atomic<int> numDropped { 0 };
+
+    // Set by prepare() and reset() on whichever thread prepares the processor, read by the timer.
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<bool> resetPending { false };
+
+    // Message thread only.
+    std::vector<float> loads, sortedLoads;
+    int numInHistory = 0;
+    int writeIndex = 0;
+    Stats stats;
+    std::unique_ptr<juce::FileOutputStream> dumpStream;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BlockProfiler)
+};
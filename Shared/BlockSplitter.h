@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    BlockSplitter.h
+    Created: 17 Oct 2026 11:58:09pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Lets MIDI controllers move a processor's parameters at the exact sample they
+    arrive on, rather than at the start of the next block.
+
+    Each controller is mapped to one parameter. The block is cut at every
+    mapped controller's timestamp, the parameter is set, and the processor runs
+    each part in turn, reading its parameters once per part just as it would
+    for a whole block. Nothing is read per sample, so the kernels stay the same.
+
+    Parts shorter than minimumSubBlockSize would leave the SIMD loops with
+    almost nothing to do, so a controller that arrives sooner than that after
+    the last cut is applied at the last cut instead, and one that arrives
+    within that of the end of the block is applied that far from the end. Either
+    way it moves by a handful of samples at most, and a block with no
+    controllers in it isn't cut at all.
+
+    Like PresetBank, the audio thread sets the values quietly and a message
+    tells the host and the editor about them afterwards.
+*/
+class BlockSplitter  : private juce::AsyncUpdater
+{
+public:
+    /** A MIDI controller number, on any channel, and the parameter it moves across its whole range. */
+    struct Mapping
+    {
+        int controller;
+        juce::RangedAudioParameter* parameter;
+    };
+
+    /** Short enough for the controllers to still land within a millisecond, long enough to fill several SIMD registers. */
+    static constexpr int defaultMinimumSubBlockSize = 32;
+
+    explicit BlockSplitter (int minimumSubBlockSizeToUse = defaultMinimumSubBlockSize)
+        : minimumSubBlockSize (juce::jmax (1, minimumSubBlockSizeToUse))
+    {
+    }
+
+    ~BlockSplitter() override
+    {
+        cancelPendingUpdate();
+    }
+
+    /** Sets which controllers move which parameters. Call this from the processor's constructor. */
+    void setMappings (std::vector<Mapping> newMappings)
+    {
+        mappings = std::move (newMappings);
+        changed = std::make_unique<std::atomic<bool>[]> (mappings.size());
+    }
+
+    /** Runs processSubBlock over the buffer, split at every mapped controller. Each part is a
+        buffer pointing into the original one, so nothing is copied.
+    */
+    template <typename SampleType, typename SubBlockFunction>
+    void process (juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages, SubBlockFunction&& processSubBlock)
+    {
+        auto numSamples = buffer.getNumSamples();
+        int start = 0;
+
+        for (const auto metadata : midiMessages)
+        {
+            auto message = metadata.getMessage();
+            auto index = findMapping (message);
+
+            if (index < 0)
+                continue;
+
+            // Too close to the end, the cut moves back so the last part isn't left short.
+            auto position = juce::jmin (juce::jlimit (0, numSamples, metadata.samplePosition), numSamples - minimumSubBlockSize);
+
+            // Too close to the last cut, the change is brought forward to it instead.
+            if (position - start >= minimumSubBlockSize)
+            {
+                juce::AudioBuffer<SampleType> subBlock (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, position - start);
+                processSubBlock (subBlock);
+                start = position;
+            }
+
+            apply (index, message);
+        }
+
+        if (start == 0)
+        {
+            processSubBlock (buffer);
+        }
+        else if (start < numSamples)
+        {
+            juce::AudioBuffer<SampleType> subBlock (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, numSamples - start);
+            processSubBlock (subBlock);
+        }
+    }
+
+    /** Sets every mapped controller without processing anything, for a block that is skipped. */
+    void applyAll (const juce::MidiBuffer& midiMessages) noexcept
+    {
+        for (const auto metadata : midiMessages)
+        {
+            auto message = metadata.getMessage();
+            auto index = findMapping (message);
+
+            if (index >= 0)
+                apply (index, message);
+        }
+    }
+
+private:
+    int findMapping (const juce::MidiMessage& message) const noexcept
+    {
+        if (! message.isController())
+            return -1;
+
+        for (size_t i = 0; i < mappings.size(); ++i)
+            if (mappings[i].controller == message.getControllerNumber())
+                return (int) i;
+
+        return -1;
+    }
+
+    void apply (int index, const juce::MidiMessage& message) noexcept
+    {
+        mappings[(size_t) index].parameter->setValue ((float) message.getControllerValue() / 127.0f);
+        changed[(size_t) index] = true;
+        triggerAsyncUpdate();
+    }
+
+    // Tells the host and the editor about the values the audio thread set.
+    void handleAsyncUpdate() override
+    {
+        for (size_t i = 0; i < mappings.size(); ++i)
+            if (changed[i].exchange (false))
+                mappings[i].parameter->sendValueChangedMessageToListeners (mappings[i].parameter->getValue());
+    }
+
+    //==============================================================================
+    const int minimumSubBlockSize;
+    std::vector<Mapping> mappings;
+
+    // Audio thread to the message thread, one flag per mapping.
+    std::unique_ptr<std::atomic<bool>[]> changed;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BlockSplitter)
+};
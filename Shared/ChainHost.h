@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    ChainHost.h
+    Created: 18 Oct 2026 12:52:30am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PluginRegistry.h"
+
+//==============================================================================
+/**
+    Runs several of the tutorial processors one after another on the same buffer,
+    like a host's insert chain but without the host in between.
+
+    A host treats each plugin as its own stop, copying the audio into the
+    plugin's buffers and back out again at every one. Every processor here works
+    in place and they all share one channel layout, so the chain just hands the
+    same buffer to each of them in turn. There are no copies between them and no
+    graph to walk, and nothing is allocated once the chain is prepared.
+
+    The default chain is the order the tutorials would sit in a session: the
+    DemoProject gain, then the DistortionAO clipper, then the Autopanner.
+
+    The plugins map the same controller numbers to their own parameters, so one
+    controller sent to all of them would move the gain, the drive and the LFO
+    together. Instead each processor listens on its own MIDI channel, the first
+    processor on channel 1, the second on channel 2 and so on. Messages that
+    have no channel, such as sysex, go to every processor.
+*/
+class ChainHost
+{
+public:
+    /** Gain, then distortion, then autopan. */
+    static juce::StringArray getDefaultChain()           { return { "DemoProject", "DistortionAO", "Autopanner" }; }
+
+    /** Creates the processors by name, in the order the audio goes through them. Names the
+        registry doesn't know are left out, so check getNumProcessors() if that matters.
+    */
+    explicit ChainHost (const juce::StringArray& pluginNames = getDefaultChain())
+    {
+        for (auto& name : pluginNames)
+            if (auto processor = PluginRegistry::createPlugin (name))
+                processors.push_back (std::move (processor));
+
+        nodeMidi.resize (processors.size());
+    }
+
+    ~ChainHost()
+    {
+        release();
+    }
+
+    int getNumProcessors() const noexcept                { return (int) processors.size(); }
+    juce::AudioProcessor& getProcessor (int index)       { return *processors[(size_t) index]; }
+
+    //==============================================================================
+    /** Gives every processor the same number of input and output channels, which is what lets
+        them all work on one buffer. Returns false if any of them can't take it.
+    */
+    bool setChannelLayout (int numChannels)
+    {
+        for (auto& processor : processors)
+            if (! PluginRegistry::setChannelLayout (*processor, numChannels))
+                return false;
+
+        return true;
+    }
+
+    /** Double precision only if every processor has a double path, otherwise the whole chain stays in floats. */
+    bool setDoublePrecision (bool shouldUseDoubles)
+    {
+        auto canUseDoubles = std::all_of (processors.begin(), processors.end(), [] (const auto& processor)
+        {
+            return processor->supportsDoublePrecisionProcessing();
+        });
+
+        doublePrecision = shouldUseDoubles && canUseDoubles;
+
+        for (auto& processor : processors)
+            processor->setProcessingPrecision (doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                               : juce::AudioProcessor::singlePrecision);
+
+        return doublePrecision == shouldUseDoubles;
+    }
+
+    void prepare (double sampleRate, int maximumBlockSize, bool isNonRealtime = false)
+    {
+        release();
+
+        for (auto& processor : processors)
+        {
+            processor->setNonRealtime (isNonRealtime);
+            processor->setRateAndBufferSizeDetails (sampleRate, maximumBlockSize);
+            processor->prepareToPlay (sampleRate, maximumBlockSize);
+        }
+
+        // Room for a busy block's worth of events each, so sorting the MIDI out never allocates.
+        for (auto& midi : nodeMidi)
+            midi.ensureSize (2048);
+
+        prepared = true;
+    }
+
+    void release()
+    {
+        if (! prepared)
+            return;
+
+        for (auto& processor : processors)
+            processor->releaseResources();
+
+        prepared = false;
+    }
+
+    /** The delays of every processor add up, as each one delays what the one before it made. */
+    int getLatencySamples() const
+    {
+        int latency = 0;
+
+        for (auto& processor : processors)
+            latency += processor->getLatencySamples();
+
+        return latency;
+    }
+
+    //==============================================================================
+    /** Runs the whole chain over the buffer in place. Each processor is only given the
+        messages on its own MIDI channel, its index in the chain plus one.
+    */
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages)
+    {
+        jassert (prepared);
+        jassert (doublePrecision == (std::is_same_v<SampleType, double>));
+
+        for (auto& midi : nodeMidi)
+            midi.clear();
+
+        for (const auto metadata : midiMessages)
+        {
+            auto message = metadata.getMessage();
+            auto channel = message.getChannel();
+
+            for (size_t i = 0; i < nodeMidi.size(); ++i)
+                if (channel == 0 || channel == (int) i + 1)
+                    nodeMidi[i].addEvent (message, metadata.samplePosition);
+        }
+
+        for (size_t i = 0; i < processors.size(); ++i)
+            processors[i]->processBlock (buffer, nodeMidi[i]);
+    }
+
+private:
+    std::vector<std::unique_ptr<juce::AudioProcessor>> processors;
+
+    // Each processor's share of the block's MIDI, in the same order as the processors.
+    std::vector<juce::MidiBuffer> nodeMidi;
+    bool doublePrecision = false;
+    bool prepared = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChainHost)
+};
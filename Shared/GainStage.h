@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    GainStage.h
+    Created: 17 Oct 2026 6:10:05pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ParameterSmoother.h"
+
+//==============================================================================
+/**
+    A trim stage that multiplies any number of channels by one gain.
+
+    The gain is set once per block. While it is settled each channel is a single
+    FloatVectorOperations call, and a gain of exactly 1 costs nothing at all when
+    working in place. Only after the gain has changed does it ramp, with the ramp
+    shared between all of the channels.
+
+    It can work in place on one buffer, or read from one buffer and write to
+    another so a chain can use it as the copy between two stages for free.
+*/
+template <typename FloatType>
+class GainStage
+{
+public:
+    GainStage() = default;
+
+    /** Allocates the ramp, call this from prepareToPlay(). */
+    void prepare (double sampleRate, int maximumBlockSize, double rampSeconds = 0.02)
+    {
+        // Linear, so the gain can go all the way down to 0 and back.
+        smoother.prepare (sampleRate, maximumBlockSize, rampSeconds, ParameterSmoother<FloatType>::Mode::linear);
+        maxBlockSize = juce::jmax (1, maximumBlockSize);
+    }
+
+    /** Jumps straight to a gain, with no ramp. */
+    void reset (FloatType newGain) noexcept         { smoother.setCurrentAndTargetValue (newGain); }
+
+    /** Sets the gain for the next block, call this once at the start of each one. */
+    void setGain (FloatType newGain) noexcept       { smoother.setTargetValue (newGain); }
+
+    FloatType getGain() const noexcept              { return smoother.getTargetValue(); }
+
+    /** Applies the gain to the buffer in place. */
+    void process (juce::AudioBuffer<FloatType>& buffer) noexcept
+    {
+        smoother.applyGain (buffer, buffer.getNumSamples());
+    }
+
+    /** Writes the source multiplied by the gain into the destination, leaving the source alone.
+        Both buffers must have the same number of channels and samples.
+    */
+    void process (const juce::AudioBuffer<FloatType>& source, juce::AudioBuffer<FloatType>& destination) noexcept
+    {
+        jassert (source.getNumChannels() == destination.getNumChannels());
+        jassert (source.getNumSamples() == destination.getNumSamples());
+
+        auto numChannels = juce::jmin (source.getNumChannels(), destination.getNumChannels());
+        auto numSamples = juce::jmin (source.getNumSamples(), destination.getNumSamples());
+
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            auto numThisTime = juce::jmin (maxBlockSize, numSamples - start);
+
+            if (smoother.isSmoothing())
+            {
+                auto* gains = smoother.renderRamp (numThisTime);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    juce::FloatVectorOperations::multiply (destination.getWritePointer (channel, start),
+                                                           source.getReadPointer (channel, start), gains, numThisTime);
+            }
+            else
+            {
+                auto gain = smoother.getTargetValue();
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    auto* dest = destination.getWritePointer (channel, start);
+                    auto* src = source.getReadPointer (channel, start);
+
+                    if (gain == (FloatType) 1)
+                        juce::FloatVectorOperations::copy (dest, src, numThisTime);
+                    else if (gain == (FloatType) 0)
+                        juce::FloatVectorOperations::clear (dest, numThisTime);
+                    else
+                        juce::FloatVectorOperations::copyWithMultiply (dest, src, gain, numThisTime);
+                }
+            }
+        }
+    }
+
+private:
+    ParameterSmoother<FloatType> smoother;
+    int maxBlockSize = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GainStage)
+};
@@ -0,0 +1,465 @@
+/*
+  ==============================================================================
+
+    GraphScheduler.cpp
+    Created: 18 Oct 2026 1:17:05am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "GraphScheduler.h"
+#include "PluginRegistry.h"
+
+//==============================================================================
+// Sleeps between cycles and works through the ready list during one.
+class GraphScheduler::Worker  : public juce::Thread
+{
+public:
+    Worker (GraphScheduler& schedulerToUse, int index)
+        : juce::Thread ("Graph worker " + juce::String (index)),
+          scheduler (schedulerToUse)
+    {
+    }
+
+    ~Worker() override
+    {
+        stop();
+    }
+
+    void start (double blockMilliseconds)
+    {
+        // Asks for the same treatment as the audio thread, and settles for the highest priority if that isn't allowed.
+        if (! startRealtimeThread (juce::Thread::RealtimeOptions().withPeriodMs (blockMilliseconds)))
+            startThread (juce::Thread::Priority::highest);
+    }
+
+    void stop()
+    {
+        signalThreadShouldExit();
+        cycleStarted.signal();
+        stopThread (1000);
+    }
+
+    void wake() noexcept
+    {
+        cycleStarted.signal();
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            cycleStarted.wait (-1.0);
+
+            if (threadShouldExit())
+                break;
+
+            scheduler.workOnCycle();
+        }
+    }
+
+private:
+    GraphScheduler& scheduler;
+    juce::WaitableEvent cycleStarted;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+void GraphScheduler::Timing::add (juce::int64 ticks) noexcept
+{
+    // Only one thread adds to a timing at once, so there is no need for a compare and swap.
+    lastTicks.store (ticks, std::memory_order_relaxed);
+    totalTicks.store (totalTicks.load (std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+
+    if (ticks > maxTicks.load (std::memory_order_relaxed))
+        maxTicks.store (ticks, std::memory_order_relaxed);
+
+    count.fetch_add (1, std::memory_order_release);
+}
+
+void GraphScheduler::Timing::reset() noexcept
+{
+    lastTicks = 0;
+    totalTicks = 0;
+    maxTicks = 0;
+    count = 0;
+}
+
+//==============================================================================
+GraphScheduler::GraphScheduler (int numThreads)
+    : numThreadsToUse (numThreads > 0 ? numThreads : juce::SystemStats::getNumCpus())
+{
+}
+
+GraphScheduler::~GraphScheduler()
+{
+    release();
+}
+
+int GraphScheduler::addNode (std::unique_ptr<juce::AudioProcessor> processor)
+{
+    jassert (! prepared && processor != nullptr);
+
+    auto node = std::make_unique<Node>();
+    node->processor = std::move (processor);
+    nodes.push_back (std::move (node));
+
+    return (int) nodes.size() - 1;
+}
+
+bool GraphScheduler::connect (int sourceNode, int destinationNode)
+{
+    jassert (! prepared);
+
+    if (! juce::isPositiveAndBelow (sourceNode, getNumNodes())
+         || ! juce::isPositiveAndBelow (destinationNode, getNumNodes())
+         || sourceNode == destinationNode)
+        return false;
+
+    // If the destination already leads back to the source, this connection would close a loop.
+    if (reaches (destinationNode, sourceNode))
+        return false;
+
+    auto& outputs = nodes[(size_t) sourceNode]->outputs;
+
+    if (std::find (outputs.begin(), outputs.end(), destinationNode) == outputs.end())
+    {
+        outputs.push_back (destinationNode);
+        nodes[(size_t) destinationNode]->inputs.push_back (sourceNode);
+    }
+
+    return true;
+}
+
+bool GraphScheduler::reaches (int fromNode, int toNode) const
+{
+    std::vector<bool> visited (nodes.size(), false);
+    std::vector<int> toVisit { fromNode };
+
+    while (! toVisit.empty())
+    {
+        auto node = toVisit.back();
+        toVisit.pop_back();
+
+        if (node == toNode)
+            return true;
+
+        if (visited[(size_t) node])
+            continue;
+
+        visited[(size_t) node] = true;
+
+        for (auto output : nodes[(size_t) node]->outputs)
+            toVisit.push_back (output);
+    }
+
+    return false;
+}
+
+//==============================================================================
+void GraphScheduler::partition()
+{
+    tasks.clear();
+    rootTasks.clear();
+    sinkTasks.clear();
+
+    // Kahn's algorithm, so every node comes after everything that feeds it.
+    std::vector<int> numInputsLeft, order;
+    std::vector<int> ready;
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        numInputsLeft.push_back ((int) nodes[i]->inputs.size());
+
+        if (nodes[i]->inputs.empty())
+            ready.push_back ((int) i);
+    }
+
+    while (! ready.empty())
+    {
+        auto node = ready.back();
+        ready.pop_back();
+        order.push_back (node);
+
+        for (auto output : nodes[(size_t) node]->outputs)
+            if (--numInputsLeft[(size_t) output] == 0)
+                ready.push_back (output);
+    }
+
+    jassert (order.size() == nodes.size());
+
+    // A node that is the only thing its only input feeds carries on that input's task in place.
+    for (auto index : order)
+    {
+        auto& node = *nodes[(size_t) index];
+
+        if (node.inputs.size() == 1 && nodes[(size_t) node.inputs[0]]->outputs.size() == 1)
+        {
+            node.task = nodes[(size_t) node.inputs[0]]->task;
+        }
+        else
+        {
+            node.task = (int) tasks.size();
+            tasks.push_back (std::make_unique<Task>());
+        }
+
+        tasks[(size_t) node.task]->nodes.push_back (index);
+    }
+
+    // The links between tasks are the links into each task's first node.
+    for (size_t t = 0; t < tasks.size(); ++t)
+    {
+        auto& task = *tasks[t];
+        auto& first = *nodes[(size_t) task.nodes.front()];
+        auto& last = *nodes[(size_t) task.nodes.back()];
+
+        for (auto input : first.inputs)
+        {
+            auto inputTask = nodes[(size_t) input]->task;
+            task.inputTasks.push_back (inputTask);
+            tasks[(size_t) inputTask]->outputTasks.push_back ((int) t);
+        }
+
+        if (task.inputTasks.empty())
+            rootTasks.push_back ((int) t);
+
+        if (last.outputs.empty())
+            sinkTasks.push_back ((int) t);
+    }
+}
+
+bool GraphScheduler::prepare (double newSampleRate, int maximumBlockSize, int newNumChannels)
+{
+    release();
+
+    sampleRate = newSampleRate;
+    blockSize = maximumBlockSize;
+    numChannels = newNumChannels;
+
+    for (auto& node : nodes)
+        if (! PluginRegistry::setChannelLayout (*node->processor, numChannels))
+            return false;
+
+    partition();
+
+    for (auto& node : nodes)
+    {
+        node->processor->setNonRealtime (false);
+        node->processor->setRateAndBufferSizeDetails (sampleRate, blockSize);
+        node->processor->prepareToPlay (sampleRate, blockSize);
+    }
+
+    // Everything a cycle touches is allocated here, up front.
+    for (auto& task : tasks)
+    {
+        task->buffer.setSize (numChannels, blockSize);
+        task->midiMessages.ensureSize (256);
+    }
+
+    readyTasks = std::make_unique<std::atomic<int>[]> (tasks.size());
+
+    for (int i = 1; i < juce::jmin (numThreadsToUse, juce::jmax (1, getNumTasks())); ++i)
+        workers.push_back (std::make_unique<Worker> (*this, i));
+
+    for (auto& worker : workers)
+        worker->start (1000.0 * blockSize / sampleRate);
+
+    resetTimings();
+    prepared = true;
+
+    return true;
+}
+
+void GraphScheduler::release()
+{
+    // The workers go first, so none of them can be in a processor that is being released.
+    for (auto& worker : workers)
+        worker->stop();
+
+    workers.clear();
+
+    if (! prepared)
+        return;
+
+    for (auto& node : nodes)
+        node->processor->releaseResources();
+
+    prepared = false;
+}
+
+//==============================================================================
+void GraphScheduler::process (const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output)
+{
+    jassert (prepared);
+    jassert (input.getNumSamples() <= blockSize && output.getNumSamples() == input.getNumSamples());
+
+    auto startTicks = juce::Time::getHighResolutionTicks();
+
+    cycleInput = &input;
+    cycleNumSamples = juce::jmin (input.getNumSamples(), blockSize);
+
+    // The threads still finishing the last cycle have all claimed past the end of it, so resetting
+    // everything before the claim index is safe. A late one that claims after that just joins in.
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        tasks[i]->pendingInputs.store ((int) tasks[i]->inputTasks.size(), std::memory_order_relaxed);
+        readyTasks[i].store (-1, std::memory_order_relaxed);
+    }
+
+    pushIndex.store (0, std::memory_order_relaxed);
+    numCompleted.store (0, std::memory_order_relaxed);
+    claimIndex.store (0, std::memory_order_release);
+
+    for (auto task : rootTasks)
+        pushReady (task);
+
+    for (auto& worker : workers)
+        worker->wake();
+
+    // This thread works too, and then waits for whatever the others are still running.
+    workOnCycle();
+
+    while (numCompleted.load (std::memory_order_acquire) < getNumTasks())
+        juce::Thread::yield();
+
+    output.clear();
+
+    for (auto task : sinkTasks)
+        for (int channel = 0; channel < juce::jmin (numChannels, output.getNumChannels()); ++channel)
+            output.addFrom (channel, 0, tasks[(size_t) task]->buffer, channel, 0, cycleNumSamples);
+
+    cycleTiming.add (juce::Time::getHighResolutionTicks() - startTicks);
+}
+
+void GraphScheduler::workOnCycle() noexcept
+{
+    const auto numTasks = getNumTasks();
+
+    for (;;)
+    {
+        auto claim = claimIndex.fetch_add (1, std::memory_order_acq_rel);
+
+        if (claim >= numTasks)
+            return;
+
+        // Every task is pushed exactly once a cycle, so this slot is always filled in the end.
+        int task;
+
+        while ((task = readyTasks[(size_t) claim].load (std::memory_order_acquire)) < 0)
+            juce::Thread::yield();
+
+        runTask (task);
+    }
+}
+
+void GraphScheduler::pushReady (int taskIndex) noexcept
+{
+    auto slot = pushIndex.fetch_add (1, std::memory_order_relaxed);
+    readyTasks[(size_t) slot].store (taskIndex, std::memory_order_release);
+}
+
+void GraphScheduler::runTask (int taskIndex) noexcept
+{
+    auto& task = *tasks[(size_t) taskIndex];
+    juce::AudioBuffer<float> block (task.buffer.getArrayOfWritePointers(), numChannels, cycleNumSamples);
+
+    // The task's input is the graph's input, or the sum of the tasks that feed it.
+    if (task.inputTasks.empty())
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            if (channel < cycleInput->getNumChannels())
+                block.copyFrom (channel, 0, *cycleInput, channel, 0, cycleNumSamples);
+            else
+                block.clear (channel, 0, cycleNumSamples);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < task.inputTasks.size(); ++i)
+        {
+            auto& source = tasks[(size_t) task.inputTasks[i]]->buffer;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                if (i == 0)
+                    block.copyFrom (channel, 0, source, channel, 0, cycleNumSamples);
+                else
+                    block.addFrom (channel, 0, source, channel, 0, cycleNumSamples);
+            }
+        }
+    }
+
+    for (auto index : task.nodes)
+    {
+        auto& node = *nodes[(size_t) index];
+        auto startTicks = juce::Time::getHighResolutionTicks();
+
+        task.midiMessages.clear();
+        node.processor->processBlock (block, task.midiMessages);
+
+        node.timing.add (juce::Time::getHighResolutionTicks() - startTicks);
+    }
+
+    // Whoever finishes the last input of a task is the one who makes it ready.
+    for (auto output : task.outputTasks)
+        if (tasks[(size_t) output]->pendingInputs.fetch_sub (1, std::memory_order_acq_rel) == 1)
+            pushReady (output);
+
+    numCompleted.fetch_add (1, std::memory_order_release);
+}
+
+//==============================================================================
+std::vector<GraphScheduler::NodeTiming> GraphScheduler::getNodeTimings() const
+{
+    auto toMicroseconds = [] (juce::int64 ticks) { return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e6; };
+
+    std::vector<NodeTiming> timings;
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        auto& timing = nodes[i]->timing;
+        auto count = timing.count.load (std::memory_order_acquire);
+
+        NodeTiming nodeTiming;
+        nodeTiming.name = nodes[i]->processor->getName() + " " + juce::String ((int) i);
+        nodeTiming.lastMicroseconds = toMicroseconds (timing.lastTicks.load (std::memory_order_relaxed));
+        nodeTiming.averageMicroseconds = count > 0 ? toMicroseconds (timing.totalTicks.load (std::memory_order_relaxed)) / count : 0.0;
+        nodeTiming.maxMicroseconds = toMicroseconds (timing.maxTicks.load (std::memory_order_relaxed));
+        timings.push_back (nodeTiming);
+    }
+
+    return timings;
+}
+
+GraphScheduler::CycleTiming GraphScheduler::getCycleTiming() const
+{
+    auto toMicroseconds = [] (juce::int64 ticks) { return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e6; };
+
+    CycleTiming timing;
+    timing.numCycles = cycleTiming.count.load (std::memory_order_acquire);
+    timing.lastMicroseconds = toMicroseconds (cycleTiming.lastTicks.load (std::memory_order_relaxed));
+    timing.averageMicroseconds = timing.numCycles > 0 ? toMicroseconds (cycleTiming.totalTicks.load (std::memory_order_relaxed)) / timing.numCycles : 0.0;
+    timing.maxMicroseconds = toMicroseconds (cycleTiming.maxTicks.load (std::memory_order_relaxed));
+
+    // How much of the time a block lasts for the cycle takes up, where 1 is all of it.
+    auto blockMicroseconds = blockSize > 0 ? 1.0e6 * blockSize / sampleRate : 0.0;
+
+    if (blockMicroseconds > 0.0)
+    {
+        timing.averageLoad = timing.averageMicroseconds / blockMicroseconds;
+        timing.maxLoad = timing.maxMicroseconds / blockMicroseconds;
+    }
+
+    return timing;
+}
+
+void GraphScheduler::resetTimings()
+{
+    for (auto& node : nodes)
+        node->timing.reset();
+
+    cycleTiming.reset();
+}
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    GraphScheduler.h
+    Created: 18 Oct 2026 1:17:05am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Runs a graph of processors, hundreds of them if need be, across a fixed pool
+    of threads.
+
+    The graph is a DAG. A node's input is the sum of everything connected into
+    it, nodes with no inputs take the graph's input, and nodes with nothing after
+    them are summed into the graph's output. There is no delay compensation, so
+    branches that merge are summed as they are.
+
+    prepare() partitions the graph in topological order. Runs of nodes where each
+    one only feeds the next become one task that works on a single buffer in
+    place, the same way ChainHost does, so only fan-outs and merges cost a copy.
+    Every task has a counter of the tasks it still waits for. A cycle resets the
+    counters and puts the tasks with no inputs on a ready list, and then the
+    calling thread and the workers take tasks off the list until every one has
+    run. Finishing a task counts down the tasks after it, and whichever thread
+    brings a counter to zero puts that task on the list.
+
+    The ready list is a plain array with two atomic indices, because every task
+    goes on it exactly once per cycle. A thread that claims a slot before its task
+    has been written just spins until it is. Nothing locks and nothing is
+    allocated once the graph is prepared.
+
+    Each node's processBlock is timed, as is each whole cycle, and both can be
+    read from any thread, for working out how many instances a machine can take.
+*/
+class GraphScheduler
+{
+public:
+    /** How long one node's processBlock takes. */
+    struct NodeTiming
+    {
+        juce::String name;
+        double lastMicroseconds = 0.0;
+        double averageMicroseconds = 0.0;
+        double maxMicroseconds = 0.0;
+    };
+
+    /** How long a whole cycle takes, and how much of the block's duration that is. */
+    struct CycleTiming
+    {
+        int numCycles = 0;
+        double lastMicroseconds = 0.0;
+        double averageMicroseconds = 0.0;
+        double maxMicroseconds = 0.0;
+        double averageLoad = 0.0;
+        double maxLoad = 0.0;
+    };
+
+    /** The thread calling process() always works too, so numThreads - 1 workers are started.
+        0 uses one thread per core.
+    */
+    explicit GraphScheduler (int numThreads = 0);
+    ~GraphScheduler();
+
+    //==============================================================================
+    /** Adds a processor to the graph and returns its node number. Only call this while the graph isn't prepared. */
+    int addNode (std::unique_ptr<juce::AudioProcessor> processor);
+
+    /** Feeds one node's output into another's input. Returns false if the nodes don't exist,
+        or if the connection would make a loop.
+    */
+    bool connect (int sourceNode, int destinationNode);
+
+    int getNumNodes() const noexcept                             { return (int) nodes.size(); }
+    juce::AudioProcessor& getProcessor (int node)                { return *nodes[(size_t) node]->processor; }
+
+    //==============================================================================
+    /** Partitions the graph, prepares every processor, allocates every buffer and starts the workers.
+        Returns false if any processor can't take numChannels channels.
+    */
+    bool prepare (double sampleRate, int maximumBlockSize, int numChannels);
+
+    /** Stops the workers and releases every processor. */
+    void release();
+
+    /** Runs the graph once. Call this from one thread at a time, with no more than the prepared block size. */
+    void process (const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output);
+
+    /** How many tasks the graph was partitioned into, and how many threads run them. */
+    int getNumTasks() const noexcept                             { return (int) tasks.size(); }
+    int getNumThreads() const noexcept                           { return (int) workers.size() + 1; }
+
+    //==============================================================================
+    std::vector<NodeTiming> getNodeTimings() const;
+    CycleTiming getCycleTiming() const;
+    void resetTimings();
+
+private:
+    class Worker;
+
+    // Written by whichever thread runs the node or the cycle, read by anyone.
+    struct Timing
+    {
+        std::atomic<juce::int64> lastTicks { 0 }, totalTicks { 0 }, maxTicks { 0 };
+        std::atomic<int> count { 0 };
+
+        void add (juce::int64 ticks) noexcept;
+        void reset() noexcept;
+    };
+
+    struct Node
+    {
+        std::unique_ptr<juce::AudioProcessor> processor;
+        std::vector<int> inputs, outputs;
+        int task = -1;
+        Timing timing;
+    };
+
+    // A run of nodes that is processed in place on one buffer.
+    struct Task
+    {
+        std::vector<int> nodes;
+        std::vector<int> inputTasks, outputTasks;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midiMessages;
+        std::atomic<int> pendingInputs { 0 };
+    };
+
+    bool reaches (int fromNode, int toNode) const;
+    void partition();
+
+    // Claims tasks until every one in the cycle has been claimed.
+    void workOnCycle() noexcept;
+    void runTask (int taskIndex) noexcept;
+    void pushReady (int taskIndex) noexcept;
+
+    //==============================================================================
+    const int numThreadsToUse;
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::vector<std::unique_ptr<Task>> tasks;
+    std::vector<int> rootTasks, sinkTasks;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    double sampleRate = 44100.0;
+    int blockSize = 0;
+    int numChannels = 0;
+    bool prepared = false;
+
+    // The current cycle.
+    const juce::AudioBuffer<float>* cycleInput = nullptr;
+    int cycleNumSamples = 0;
+    std::unique_ptr<std::atomic<int>[]> readyTasks;
+    std::atomic<int> pushIndex { 0 }, claimIndex { 0 }, numCompleted { 0 };
+
+    Timing cycleTiming;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GraphScheduler)
+};
@@ -0,0 +1,307 @@
+/*
+  ==============================================================================
+
+    ParameterSmoother.h
+    Created: 17 Oct 2026 5:32:44pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Glides a parameter to each new value instead of letting it jump, which is what
+    causes zipper noise when a control is automated.
+
+    There are three ways to glide:
+     - linear moves by the same amount each sample and arrives after the ramp time.
+     - multiplicative moves by the same ratio each sample, which sounds even for
+       gains and frequencies. It can't start or end at zero or cross it.
+     - onePole follows the target like a simple low pass filter, fast at first and
+       slowing down as it gets close. The ramp time is its time constant.
+
+    Once the value arrives it is marked as settled, and applyGain() drops to a
+    single constant multiply per channel. While it is still moving, the values for
+    the whole block are written into a ramp buffer using vector operations where
+    the mode allows it, and shared by every channel.
+*/
+template <typename FloatType>
+class ParameterSmoother
+{
+public:
+    enum class Mode
+    {
+        linear,
+        multiplicative,
+        onePole
+    };
+
+    ParameterSmoother() = default;
+
+    /** Sets the glide time and allocates the ramp buffer, call this from prepareToPlay(). */
+    void prepare (double sampleRate, int maximumBlockSize, double rampSeconds, Mode newMode)
+    {
+        mode = newMode;
+        maxBlockSize = juce::jmax (1, maximumBlockSize);
+        rampLengthInSamples = juce::jmax (1, juce::roundToInt (sampleRate * rampSeconds));
+
+        ramp.resize ((size_t) maxBlockSize);
+
+        // The linear ramp is the current value plus the step times 1, 2, 3 and so on, and
+        // the one-pole ramp decays by the pole's powers, so both are tabled once here.
+        sampleCounts.resize ((size_t) maxBlockSize);
+        polePowers.resize ((size_t) maxBlockSize);
+
+        pole = (FloatType) std::exp (-1.0 / (double) rampLengthInSamples);
+        auto power = (FloatType) 1;
+
+        for (int i = 0; i < maxBlockSize; ++i)
+        {
+            power *= pole;
+            sampleCounts[(size_t) i] = (FloatType) (i + 1);
+            polePowers[(size_t) i] = power;
+        }
+
+        setCurrentAndTargetValue (target);
+    }
+
+    /** Jumps straight to a value, with no glide. */
+    void setCurrentAndTargetValue (FloatType newValue) noexcept
+    {
+        current = target = newValue;
+        countdown = 0;
+    }
+
+    /** Starts gliding towards a new value. Calling this with the value it is already heading to does nothing. */
+    void setTargetValue (FloatType newValue) noexcept
+    {
+        if (newValue == target)
+            return;
+
+        // Multiplicative ramps can't pass through zero, so they jump instead.
+        if (mode == Mode::multiplicative && (newValue <= 0 || current <= 0))
+        {
+            setCurrentAndTargetValue (newValue);
+            return;
+        }
+
+        target = newValue;
+        countdown = rampLengthInSamples;
+
+        if (mode == Mode::linear)
+            step = (target - current) / (FloatType) countdown;
+        else if (mode == Mode::multiplicative)
+            step = (FloatType) std::exp (std::log ((double) target / (double) current) / (double) countdown);
+    }
+
+    FloatType getCurrentValue() const noexcept       { return current; }
+    FloatType getTargetValue() const noexcept        { return target; }
+
+    /** Returns true until the value has arrived at its target. */
+    bool isSmoothing() const noexcept                { return countdown > 0; }
+
+    /** Moves on one sample and returns the new value. */
+    FloatType getNextValue() noexcept
+    {
+        if (! isSmoothing())
+            return target;
+
+        switch (mode)
+        {
+            case Mode::linear:          current += step; break;
+            case Mode::multiplicative:  current *= step; break;
+            case Mode::onePole:         current = target + (current - target) * pole; break;
+        }
+
+        --countdown;
+        checkIfSettled();
+
+        return current;
+    }
+
+    /** Moves on numSamples and returns the value it ends up at, without rendering anything. */
+    FloatType skip (int numSamples) noexcept
+    {
+        if (! isSmoothing() || numSamples <= 0)
+            return current;
+
+        if (mode == Mode::onePole)
+        {
+            current = target + (current - target) * (FloatType) std::pow ((double) pole, (double) numSamples);
+            countdown = juce::jmax (0, countdown - numSamples);
+            checkIfSettled();
+            return current;
+        }
+
+        if (numSamples >= countdown)
+        {
+            setCurrentAndTargetValue (target);
+            return current;
+        }
+
+        if (mode == Mode::linear)
+            current += step * (FloatType) numSamples;
+        else
+            current *= (FloatType) std::pow ((double) step, (double) numSamples);
+
+        countdown -= numSamples;
+        return current;
+    }
+
+    /** Writes the next numSamples values into the ramp buffer and returns it. numSamples can't be
+        more than the block size passed to prepare(). The values stay valid until the next call.
+    */
+    const FloatType* renderRamp (int numSamples) noexcept
+    {
+        jassert (numSamples <= maxBlockSize);
+        numSamples = juce::jmin (numSamples, maxBlockSize);
+
+        auto* dest = ramp.data();
+
+        if (! isSmoothing())
+        {
+            juce::FloatVectorOperations::fill (dest, target, numSamples);
+            return dest;
+        }
+
+        // The part of the block still gliding, the rest is filled with the target.
+        auto numMoving = mode == Mode::onePole ? numSamples : juce::jmin (numSamples, countdown);
+
+        switch (mode)
+        {
+            case Mode::linear:
+                // current + step * (1, 2, 3...)
+                juce::FloatVectorOperations::copyWithMultiply (dest, sampleCounts.data(), step, numMoving);
+                juce::FloatVectorOperations::add (dest, current, numMoving);
+                break;
+
+            case Mode::multiplicative:
+                // Each value depends on the last, so this one has to be done a sample at a time.
+                for (int i = 0; i < numMoving; ++i)
+                    dest[i] = (current *= step);
+                break;
+
+            case Mode::onePole:
+                // target + (current - target) * (pole, pole^2, pole^3...)
+                juce::FloatVectorOperations::copyWithMultiply (dest, polePowers.data(), current - target, numMoving);
+                juce::FloatVectorOperations::add (dest, target, numMoving);
+                break;
+        }
+
+        if (numMoving < numSamples)
+            juce::FloatVectorOperations::fill (dest + numMoving, target, numSamples - numMoving);
+
+        current = dest[numMoving - 1];
+        countdown = juce::jmax (0, countdown - numMoving);
+
+        if (mode == Mode::onePole)
+            checkIfSettled();
+        else if (countdown == 0)
+            current = target;
+
+        return dest;
+    }
+
+    /** Multiplies one channel by the next numSamples values. */
+    void applyGain (FloatType* data, int numSamples) noexcept
+    {
+        // Before prepare() there is nowhere to render a ramp, and the loop below would never move on.
+        jassert (maxBlockSize > 0);
+
+        if (maxBlockSize <= 0)
+            return;
+
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            auto numThisTime = juce::jmin (maxBlockSize, numSamples - start);
+
+            if (isSmoothing())
+                juce::FloatVectorOperations::multiply (data + start, renderRamp (numThisTime), numThisTime);
+            else
+                multiplyByConstant (data + start, numThisTime);
+        }
+    }
+
+    /** Multiplies every channel of the buffer by the same next numSamples values. */
+    void applyGain (juce::AudioBuffer<FloatType>& buffer, int numSamples) noexcept
+    {
+        jassert (maxBlockSize > 0);
+
+        if (maxBlockSize <= 0)
+            return;
+
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            auto numThisTime = juce::jmin (maxBlockSize, numSamples - start);
+
+            if (isSmoothing())
+            {
+                auto* gains = renderRamp (numThisTime);
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    juce::FloatVectorOperations::multiply (buffer.getWritePointer (channel, start), gains, numThisTime);
+            }
+            else
+            {
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    multiplyByConstant (buffer.getWritePointer (channel, start), numThisTime);
+            }
+        }
+    }
+
+private:
+    // Settled gains of exactly 1 and 0 don't need a multiply at all.
+    void multiplyByConstant (FloatType* data, int numSamples) noexcept
+    {
+        if (target == (FloatType) 1)
+            return;
+
+        if (target == (FloatType) 0)
+            juce::FloatVectorOperations::clear (data, numSamples);
+        else
+            juce::FloatVectorOperations::multiply (data, target, numSamples);
+    }
+
+    // A one-pole never quite gets there, so it is snapped to the target once it is close enough to hear no difference.
+    void checkIfSettled() noexcept
+    {
+        if (mode == Mode::onePole)
+        {
+            if (std::abs (current - target) <= settledTolerance * juce::jmax ((FloatType) 1, std::abs (target)))
+                setCurrentAndTargetValue (target);
+            else
+                countdown = juce::jmax (countdown, 1);
+        }
+        else if (countdown == 0)
+        {
+            current = target;
+        }
+    }
+
+    // About -100 dB, well under anything audible.
+    static constexpr FloatType settledTolerance = (FloatType) 1.0e-5;
+
+    Mode mode = Mode::linear;
+
+    FloatType current = 0, target = 0;
+
+    // The amount added each sample for linear, the ratio for multiplicative.
+    FloatType step = 0;
+
+    // The one-pole's feedback coefficient.
+    FloatType pole = 0;
+
+    // Samples left until a linear or multiplicative ramp arrives, a one-pole keeps it above zero until it settles.
+    int countdown = 0;
+
+    int rampLengthInSamples = 1;
+    int maxBlockSize = 0;
+
+    std::vector<FloatType> ramp, sampleCounts, polePowers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterSmoother)
+};
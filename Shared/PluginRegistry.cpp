@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    PluginRegistry.cpp
+    Created: 17 Oct 2026 4:05:12pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#include "PluginRegistry.h"
+
+// Each of these is defined in its file in Shared/Plugins.
+juce::AudioProcessor* JUCE_CALLTYPE createDemoProjectFilter();
+juce::AudioProcessor* JUCE_CALLTYPE createAutopannerFilter();
+juce::AudioProcessor* JUCE_CALLTYPE createDistortionAOFilter();
+
+namespace PluginRegistry
+{
+    juce::StringArray getPluginNames()
+    {
+        return { "DemoProject", "Autopanner", "DistortionAO" };
+    }
+
+    std::unique_ptr<juce::AudioProcessor> createPlugin (const juce::String& name)
+    {
+        if (name.equalsIgnoreCase ("DemoProject"))   return std::unique_ptr<juce::AudioProcessor> (createDemoProjectFilter());
+        if (name.equalsIgnoreCase ("Autopanner"))    return std::unique_ptr<juce::AudioProcessor> (createAutopannerFilter());
+        if (name.equalsIgnoreCase ("DistortionAO"))  return std::unique_ptr<juce::AudioProcessor> (createDistortionAOFilter());
+
+        return {};
+    }
+
+    bool setParameter (juce::AudioProcessor& processor, const juce::String& parameterID, float value)
+    {
+        for (auto* parameter : processor.getParameters())
+        {
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameter))
+            {
+                if (ranged->getParameterID().equalsIgnoreCase (parameterID))
+                {
+                    ranged->setValueNotifyingHost (ranged->convertTo0to1 (value));
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool setChannelLayout (juce::AudioProcessor& processor, int numChannels)
+    {
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add (juce::AudioChannelSet::canonicalChannelSet (numChannels));
+        layout.outputBuses.add (juce::AudioChannelSet::canonicalChannelSet (numChannels));
+
+        return processor.setBusesLayout (layout);
+    }
+
+    juce::StringArray describeParameters (juce::AudioProcessor& processor)
+    {
+        juce::StringArray lines;
+
+        for (auto* parameter : processor.getParameters())
+        {
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameter))
+            {
+                auto& range = ranged->getNormalisableRange();
+
+                lines.add (ranged->getParameterID().paddedRight (' ', 14)
+                           + ranged->getName (32).paddedRight (' ', 22)
+                           + juce::String (range.start) + " to " + juce::String (range.end)
+                           + ", now " + ranged->getCurrentValueAsText());
+            }
+        }
+
+        return lines;
+    }
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    PluginRegistry.h
+    Created: 17 Oct 2026 4:05:12pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Creates the three tutorial processors by name, for the headless tools that run
+    them without a plugin host.
+
+    A tool that uses this has to compile the files in Shared/Plugins, which build
+    each plugin's sources in with its own createPluginFilter().
+*/
+namespace PluginRegistry
+{
+    /** The names createPlugin() understands, in the order the tutorials were written. */
+    juce::StringArray getPluginNames();
+
+    /** Returns a new processor, or nullptr if the name isn't one of getPluginNames().
+        The name is not case sensitive.
+    */
+    std::unique_ptr<juce::AudioProcessor> createPlugin (const juce::String& name);
+
+    /** Sets a parameter from its ID using the parameter's own range, so a choice
+        takes an index and a float takes a real value rather than 0 to 1.
+        Returns false if the processor has no parameter with that ID.
+    */
+    bool setParameter (juce::AudioProcessor& processor, const juce::String& parameterID, float value);
+
+    /** Gives the processor's main input and output buses the given number of channels.
+        Returns false, leaving the layout alone, if the processor doesn't support it.
+    */
+    bool setChannelLayout (juce::AudioProcessor& processor, int numChannels);
+
+    /** One line per parameter with its ID, name, range and current value. */
+    juce::StringArray describeParameters (juce::AudioProcessor& processor);
+}
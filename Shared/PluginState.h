@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    PluginState.h
+    Created: 17 Oct 2026 10:58:16pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Saves every parameter of a processor into the host's session, and reads them
+    back, for getStateInformation() and setStateInformation().
+
+    The state is a small ValueTree written in JUCE's binary format, a STATE node
+    holding the version it was saved with, the preset that was loaded and one
+    PARAM child per parameter. Values are stored as their real values (a gain,
+    a number of milliseconds, a choice's index) rather than the host's 0 to 1
+    values, so a parameter's range can change without breaking old sessions.
+
+    Parameters are found by their IDs. One that the state doesn't mention, because
+    it was added after the session was saved, goes back to its default, and one
+    the processor no longer has is ignored. A state saved by a later version is
+    read the same way. When a change needs more than that, the processor bumps its
+    version and passes a Migration that rewrites older trees before they're read.
+*/
+namespace PluginState
+{
+    /** Rewrites a state saved with an older version, in place, before it is read. */
+    using Migration = std::function<void (juce::ValueTree& state, int savedVersion)>;
+
+    /** The parameter values, from 0 to 1 in the processor's parameter order, and the preset that was loaded. */
+    struct Snapshot
+    {
+        std::vector<float> values;
+        int preset = 0;
+    };
+
+    namespace Ids
+    {
+        static const juce::Identifier state { "STATE" };
+        static const juce::Identifier param { "PARAM" };
+        static const juce::Identifier version { "version" };
+        static const juce::Identifier preset { "preset" };
+        static const juce::Identifier id { "id" };
+        static const juce::Identifier value { "value" };
+    }
+
+    /** Writes every parameter of the processor into destData, taking the values from 0 to 1 in the
+        processor's parameter order rather than from the parameters themselves.
+    */
+    inline void save (const juce::AudioProcessor& processor, int version, int currentPreset,
+                      const std::vector<float>& values, juce::MemoryBlock& destData)
+    {
+        auto& parameters = processor.getParameters();
+        jassert (values.size() == (size_t) parameters.size());
+
+        juce::ValueTree state (Ids::state);
+        state.setProperty (Ids::version, version, nullptr);
+        state.setProperty (Ids::preset, currentPreset, nullptr);
+
+        for (int i = 0; i < parameters.size(); ++i)
+        {
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameters[i]))
+            {
+                juce::ValueTree param (Ids::param);
+                param.setProperty (Ids::id, ranged->getParameterID(), nullptr);
+                param.setProperty (Ids::value, ranged->convertFrom0to1 (values[(size_t) i]), nullptr);
+                state.appendChild (param, nullptr);
+            }
+        }
+
+        juce::MemoryOutputStream stream (destData, false);
+        state.writeToStream (stream);
+    }
+
+    /** Writes every parameter of the processor into destData, as the parameters are now. */
+    inline void save (const juce::AudioProcessor& processor, int version, int currentPreset, juce::MemoryBlock& destData)
+    {
+        std::vector<float> values;
+
+        for (auto* parameter : processor.getParameters())
+            values.push_back (parameter->getValue());
+
+        save (processor, version, currentPreset, values, destData);
+    }
+
+    /** Reads a state written by save(). Returns nothing if the data is empty or isn't a state at all,
+        which is what sessions saved before there was any state look like.
+    */
+    inline std::optional<Snapshot> load (const juce::AudioProcessor& processor, const void* data, int sizeInBytes,
+                                         int currentVersion, const Migration& migrate = {})
+    {
+        if (data == nullptr || sizeInBytes <= 0)
+            return {};
+
+        auto state = juce::ValueTree::readFromData (data, (size_t) sizeInBytes);
+
+        if (! state.isValid() || ! state.hasType (Ids::state))
+            return {};
+
+        auto savedVersion = (int) state.getProperty (Ids::version, 0);
+
+        if (savedVersion < currentVersion && migrate)
+            migrate (state, savedVersion);
+
+        Snapshot snapshot;
+        snapshot.preset = (int) state.getProperty (Ids::preset, 0);
+
+        for (auto* parameter : processor.getParameters())
+        {
+            auto value = parameter->getDefaultValue();
+
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameter))
+            {
+                for (int i = 0; i < state.getNumChildren(); ++i)
+                {
+                    auto param = state.getChild (i);
+
+                    if (param.hasType (Ids::param) && param.getProperty (Ids::id).toString() == ranged->getParameterID())
+                    {
+                        value = ranged->convertTo0to1 ((float) param.getProperty (Ids::value));
+                        break;
+                    }
+                }
+            }
+
+            snapshot.values.push_back (value);
+        }
+
+        return snapshot;
+    }
+}
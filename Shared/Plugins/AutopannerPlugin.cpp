@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    AutopannerPlugin.cpp
+    Created: 17 Oct 2026 4:05:12pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+// Builds the Autopanner plugin into a headless host, see DemoProjectPlugin.cpp.
+#define JucePlugin_Name "Autopanner"
+#define createPluginFilter createAutopannerFilter
+
+#include "../../Autopanner/Source/PluginProcessor.cpp"
+#include "../../Autopanner/Source/PluginEditor.cpp"
+#include "../../Autopanner/Source/PanLfo.cpp"
+#include "../../Autopanner/Source/SurroundPanner.cpp"
+#include "../../Autopanner/Source/VoicePanner.cpp"
@@ -0,0 +1,18 @@
+/*
+  ==============================================================================
+
+    DemoProjectPlugin.cpp
+    Created: 17 Oct 2026 4:05:12pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+// Builds the DemoProject plugin into a headless host. The plugin sources expect the
+// Projucer to define JucePlugin_Name, and every plugin has its own createPluginFilter(),
+// so both are set up here before pulling the sources in.
+#define JucePlugin_Name "DemoProject"
+#define createPluginFilter createDemoProjectFilter
+
+#include "../../DemoProject/Source/PluginProcessor.cpp"
+#include "../../DemoProject/Source/PluginEditor.cpp"
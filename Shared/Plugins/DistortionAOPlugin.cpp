@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    DistortionAOPlugin.cpp
+    Created: 17 Oct 2026 4:05:12pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+// Builds the DistortionAO plugin into a headless host, see DemoProjectPlugin.cpp.
+#define JucePlugin_Name "DistortionAO"
+#define createPluginFilter createDistortionAOFilter
+
+#include "../../DistortionAO/Source/PluginProcessor.cpp"
+#include "../../DistortionAO/Source/PluginEditor.cpp"
+#include "../../DistortionAO/Source/OversamplingStage.cpp"
+#include "../../DistortionAO/Source/AntiderivativeClipper.cpp"
+#include "../../DistortionAO/Source/LevelMeter.cpp"
+#include "../../DistortionAO/Source/ScopeBuffer.cpp"
+#include "../../DistortionAO/Source/ScopeComponent.cpp"
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 17 Oct 2026 11:07:42pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PluginState.h"
+
+//==============================================================================
+/**
+    A processor's factory presets, and the one place new parameter values are
+    handed to the audio thread, whether they come from a preset or a session.
+
+    Setting the parameters one at a time from the message thread would let a
+    block start with half of a preset applied. Instead the new values are copied
+    into a pending snapshot, and the audio thread sets all of them at the top of
+    its next block, before anything reads them. Only the copy is guarded, by a
+    SpinLock the audio thread only ever tries to take. If the message thread is in
+    the middle of writing, the audio thread leaves it for the next block rather
+    than waiting, so switching presets never causes a dropout.
+
+    The audio thread sets the values quietly, then a message tells the host and
+    the editor about all of them at once. While the processor isn't prepared
+    there are no blocks to wait for, so the values are set straight away. A
+    prepared host can still be stopped, so saving the state while values are
+    waiting writes the waiting values, not the ones they are about to replace.
+*/
+class PresetBank  : private juce::AsyncUpdater
+{
+public:
+    /** A preset's name and the real value of each parameter by ID. Parameters it leaves out go to their defaults. */
+    struct Preset
+    {
+        juce::String name;
+        std::vector<std::pair<juce::String, float>> values;
+    };
+
+    explicit PresetBank (juce::AudioProcessor& processorToControl)
+        : processor (processorToControl)
+    {
+    }
+
+    ~PresetBank() override
+    {
+        cancelPendingUpdate();
+    }
+
+    /** Sets the factory presets. Call this at the end of the processor's constructor, once every parameter has been added. */
+    void setPresets (const std::vector<Preset>& newPresets)
+    {
+        parameters.clear();
+
+        for (auto* parameter : processor.getParameters())
+            parameters.push_back (parameter);
+
+        // Work out each preset's 0 to 1 values now, so loading one is just a copy.
+        presets.clear();
+
+        for (auto& preset : newPresets)
+        {
+            std::vector<float> values;
+
+            for (auto* parameter : parameters)
+            {
+                auto value = parameter->getDefaultValue();
+
+                if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameter))
+                    for (auto& [id, realValue] : preset.values)
+                        if (id == ranged->getParameterID())
+                            value = ranged->convertTo0to1 (realValue);
+
+                values.push_back (value);
+            }
+
+            presets.push_back ({ preset.name, std::move (values) });
+        }
+
+        // Sized once here, so staging and applying values never allocates.
+        pendingValues.resize (parameters.size());
+    }
+
+    //==============================================================================
+    /** There is always at least one program, some hosts don't cope with none. */
+    int getNumPresets() const noexcept                  { return juce::jmax (1, (int) presets.size()); }
+
+    juce::String getPresetName (int index) const
+    {
+        return juce::isPositiveAndBelow (index, (int) presets.size()) ? presets[(size_t) index].name : juce::String();
+    }
+
+    int getCurrentPreset() const noexcept               { return currentPreset.load(); }
+
+    /** Switches to one of the presets. Safe to call from any thread but the audio thread. */
+    void loadPreset (int index)
+    {
+        if (! juce::isPositiveAndBelow (index, (int) presets.size()))
+            return;
+
+        currentPreset = index;
+        stage (presets[(size_t) index].values);
+    }
+
+    //==============================================================================
+    /** Writes the current values and preset into the host's session. Safe to call from any thread but the audio thread. */
+    void saveState (int version, juce::MemoryBlock& destData)
+    {
+        std::vector<float> values;
+
+        {
+            // A preset or session that hasn't reached a block yet is what the plugin is about to be, so that's what gets saved.
+            const juce::SpinLock::ScopedLockType lock (pendingLock);
+
+            if (hasPending.load (std::memory_order_acquire))
+                values = pendingValues;
+        }
+
+        if (values.empty())
+            for (auto* parameter : parameters)
+                values.push_back (parameter->getValue());
+
+        PluginState::save (processor, version, currentPreset, values, destData);
+    }
+
+    /** Restores a session saved by saveState(), applied at the next block like a preset. */
+    void restoreState (const void* data, int sizeInBytes, int version, const PluginState::Migration& migrate = {})
+    {
+        if (auto snapshot = PluginState::load (processor, data, sizeInBytes, version, migrate))
+        {
+            currentPreset = juce::jlimit (0, getNumPresets() - 1, snapshot->preset);
+            stage (snapshot->values);
+        }
+    }
+
+    //==============================================================================
+    /** Call these from prepareToPlay() and releaseResources(), so the bank knows whether blocks are coming. */
+    void prepare() noexcept                             { prepared = true; }
+
+    void release()
+    {
+        prepared = false;
+
+        // Anything still waiting for a block won't get one now.
+        const juce::SpinLock::ScopedLockType lock (pendingLock);
+
+        if (hasPending.exchange (false))
+            for (size_t i = 0; i < parameters.size(); ++i)
+                parameters[i]->setValueNotifyingHost (pendingValues[i]);
+    }
+
+    /** Sets every pending value at once. Call this at the top of processBlock, before any parameter is read. */
+    void applyPendingValues() noexcept
+    {
+        if (! hasPending.load (std::memory_order_acquire))
+            return;
+
+        const juce::SpinLock::ScopedTryLockType lock (pendingLock);
+
+        // The message thread is still writing, the values will be picked up by the next block instead.
+        if (! lock.isLocked())
+            return;
+
+        for (size_t i = 0; i < parameters.size(); ++i)
+            parameters[i]->setValue (pendingValues[i]);
+
+        hasPending = false;
+        needsNotifying = true;
+        triggerAsyncUpdate();
+    }
+
+private:
+    void stage (const std::vector<float>& values)
+    {
+        jassert (values.size() == parameters.size());
+
+        if (! prepared)
+        {
+            // Nothing is processing, so there's no block to wait for.
+            for (size_t i = 0; i < parameters.size(); ++i)
+                parameters[i]->setValueNotifyingHost (values[i]);
+
+            return;
+        }
+
+        const juce::SpinLock::ScopedLockType lock (pendingLock);
+        std::copy (values.begin(), values.end(), pendingValues.begin());
+        hasPending.store (true, std::memory_order_release);
+    }
+
+    // Tells the host and the editor about the values the audio thread set.
+    void handleAsyncUpdate() override
+    {
+        if (! needsNotifying.exchange (false))
+            return;
+
+        for (auto* parameter : parameters)
+            parameter->sendValueChangedMessageToListeners (parameter->getValue());
+
+        processor.updateHostDisplay (juce::AudioProcessor::ChangeDetails().withProgramChanged (true));
+    }
+
+    //==============================================================================
+    struct StoredPreset
+    {
+        juce::String name;
+        std::vector<float> values;
+    };
+
+    juce::AudioProcessor& processor;
+    std::vector<juce::AudioProcessorParameter*> parameters;
+    std::vector<StoredPreset> presets;
+    std::atomic<int> currentPreset { 0 };
+
+    // Message thread to audio thread.
+    juce::SpinLock pendingLock;
+    std::vector<float> pendingValues;
+    std::atomic<bool> hasPending { false };
+    std::atomic<bool> prepared { false };
+
+    // Audio thread back to the message thread.
+    std::atomic<bool> needsNotifying { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBank)
+};
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    ProfiledGenericEditor.h
+    Created: 17 Oct 2026 8:36:47pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ProfilerComponent.h"
+
+//==============================================================================
+/**
+    JUCE's generic parameter editor with a ProfilerComponent underneath, for the
+    plugins that don't have an editor of their own.
+*/
+class ProfiledGenericEditor  : public juce::AudioProcessorEditor
+{
+public:
+    ProfiledGenericEditor (juce::AudioProcessor& p, BlockProfiler& profiler)
+        : AudioProcessorEditor (&p),
+          genericEditor (p),
+          profilerComponent (profiler, p.getName())
+    {
+        addAndMakeVisible (genericEditor);
+        addAndMakeVisible (profilerComponent);
+
+        setSize (juce::jmax (300, genericEditor.getWidth()), genericEditor.getHeight() + ProfilerComponent::preferredHeight);
+    }
+
+    void resized() override
+    {
+        auto area = getLocalBounds();
+        profilerComponent.setBounds (area.removeFromBottom (ProfilerComponent::preferredHeight));
+        genericEditor.setBounds (area);
+    }
+
+private:
+    juce::GenericAudioProcessorEditor genericEditor;
+    ProfilerComponent profilerComponent;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProfiledGenericEditor)
+};
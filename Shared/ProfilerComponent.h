@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    ProfilerComponent.h
+    Created: 17 Oct 2026 8:31:02pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BlockProfiler.h"
+
+//==============================================================================
+/**
+    A strip for the bottom of an editor showing a BlockProfiler's figures, with a
+    button that writes every block to a CSV file in the user's documents folder.
+
+    It only reads the figures the profiler has already worked out on the message
+    thread, so it never touches anything the audio thread uses.
+*/
+class ProfilerComponent  : public juce::Component,
+                           private juce::Timer
+{
+public:
+    ProfilerComponent (BlockProfiler& profilerToShow, const juce::String& pluginName)
+        : profiler (profilerToShow),
+          dumpFile (juce::File::getSpecialLocation (juce::File::userDocumentsDirectory).getChildFile (pluginName + " Profile.csv"))
+    {
+        dumpButton.setToggleState (profiler.isDumping(), juce::dontSendNotification);
+        dumpButton.onClick = [this]
+        {
+            if (dumpButton.getToggleState())
+                dumpButton.setToggleState (profiler.startDump (dumpFile), juce::dontSendNotification);
+            else
+                profiler.stopDump();
+        };
+
+        dumpButton.setTooltip (dumpFile.getFullPathName());
+        addAndMakeVisible (dumpButton);
+
+        // The figures only change when the profiler's own timer runs, so there is no point redrawing faster than that.
+        startTimerHz (4);
+    }
+
+    ~ProfilerComponent() override
+    {
+        stopTimer();
+    }
+
+    /** The height the strip needs for its two lines. */
+    static constexpr int preferredHeight = 44;
+
+    //==============================================================================
+    void paint (juce::Graphics& g) override
+    {
+        auto& stats = profiler.getStats();
+        auto area = getLocalBounds().reduced (6, 2).removeFromTop (20);
+
+        g.setColour (juce::Colours::darkgrey.darker());
+        g.fillRect (getLocalBounds());
+
+        // Anything over half the deadline is worth noticing.
+        g.setColour (stats.p99 > 50.0f ? juce::Colours::orange : juce::Colours::lightgrey);
+        g.setFont (13.0f);
+
+        auto percent = [] (float value) { return juce::String (value, 1) + "%"; };
+
+        g.drawText ("CPU  min " + percent (stats.minimum) + "  avg " + percent (stats.average)
+                      + "  p99 " + percent (stats.p99) + "  max " + percent (stats.maximum),
+                    area, juce::Justification::centredLeft, true);
+    }
+
+    void resized() override
+    {
+        dumpButton.setBounds (getLocalBounds().reduced (6, 2).removeFromBottom (20));
+    }
+
+private:
+    void timerCallback() override
+    {
+        repaint();
+    }
+
+    BlockProfiler& profiler;
+    juce::File dumpFile;
+    juce::ToggleButton dumpButton { "Log every block to a file" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProfilerComponent)
+};
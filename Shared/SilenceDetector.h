@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    SilenceDetector.h
+    Created: 17 Oct 2026 11:41:26pm
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Spots when a processor's input has gone silent, so it can skip the block
+    entirely and just output silence.
+
+    Sessions often have long silent tails, and those are exactly where a filter
+    or a curve ends up working on numbers so small the CPU handles them in
+    microcode, tens of times slower than normal. ScopedNoDenormals flushes them
+    to zero while a block runs, and this goes one step further by not running
+    the block at all.
+
+    Each channel is checked with FloatVectorOperations::findMinAndMax, which is
+    SIMD and reads the block once. A block counts as silent when every sample is
+    below -140 dB, which is under the quietest step of a 24 bit converter. A
+    processor with memory still has to let its filters ring out after the input
+    stops, so it sets a tail, and blocks are only skipped once the input has been
+    silent for at least that long.
+*/
+class SilenceDetector
+{
+public:
+    SilenceDetector() = default;
+
+    /** How long the processor keeps making sound after its input stops. 0 for one without any memory. */
+    void setTailLength (int numSamples) noexcept    { tailSamples = juce::jmax (0, numSamples); }
+
+    /** Starts counting again, call this from prepareToPlay(). */
+    void reset() noexcept
+    {
+        silentSamples = 0;
+        skipping = false;
+        startedSkipping = false;
+    }
+
+    /** Checks the block before it is processed, returning true if it can be skipped and cleared. */
+    template <typename SampleType>
+    bool process (const juce::AudioBuffer<SampleType>& buffer) noexcept
+    {
+        auto wasSkipping = skipping;
+
+        if (isSilent (buffer))
+        {
+            // The tail has to have finished before this block starts, or the block would cut it off.
+            skipping = silentSamples >= tailSamples;
+            silentSamples = juce::jmin (tailSamples, silentSamples + buffer.getNumSamples());
+        }
+        else
+        {
+            skipping = false;
+            silentSamples = 0;
+        }
+
+        startedSkipping = skipping && ! wasSkipping;
+        return skipping;
+    }
+
+    /** True for the first block that was skipped, where a processor can clear out whatever is left in its filters. */
+    bool hasJustStartedSkipping() const noexcept    { return startedSkipping; }
+
+    /** True if every sample of every channel is below the silence threshold. */
+    template <typename SampleType>
+    static bool isSilent (const juce::AudioBuffer<SampleType>& buffer) noexcept
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto range = juce::FloatVectorOperations::findMinAndMax (buffer.getReadPointer (channel), buffer.getNumSamples());
+
+            if (range.getEnd() > (SampleType) silenceThreshold || range.getStart() < (SampleType) -silenceThreshold)
+                return false;
+        }
+
+        return true;
+    }
+
+    /** -140 dB. */
+    static constexpr double silenceThreshold = 1.0e-7;
+
+private:
+    int tailSamples = 0;
+    int silentSamples = 0;
+    bool skipping = false;
+    bool startedSkipping = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SilenceDetector)
+};
@@ -0,0 +1,424 @@
+/*
+  ==============================================================================
+
+    SimdOps.h
+    Created: 17 Oct 2026 11:02:51am
+    Author:  phlie
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <bit>
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#elif JUCE_ARM && (defined (__ARM_NEON) || defined (__ARM_NEON__))
+ #include <arm_neon.h>
+ #define SIMDOPS_USE_NEON 1
+#endif
+
+// Everything below is built once per instruction set, so each build gets its own name for it. Without this the
+// linker would be free to keep the AVX2 copy of a function and hand it to the SSE2 code on a CPU without AVX2.
+#if defined (__AVX2__)
+ #define SIMDOPS_TARGET avx2
+#else
+ #define SIMDOPS_TARGET baseline
+#endif
+
+// An x86 build that doesn't target AVX2 itself can still jump to a copy of the kernels compiled with it.
+#if JUCE_INTEL && ! defined (__AVX2__)
+ #define SIMDOPS_DISPATCH_AVX2 1
+#else
+ #define SIMDOPS_DISPATCH_AVX2 0
+#endif
+
+//==============================================================================
+/**
+    The handful of vector instructions the DistortionAO kernels and the
+    Autopanner's voices need.
+
+    Each set of ops has the same static functions, so a curve written once as a
+    template over the ops can run four samples at a time on SSE2 or NEON and one
+    sample at a time for whatever is left over at the end of a block.
+
+    SSE2 is the default on x86. Building with AVX2 enabled (-mavx2 or /arch:AVX2)
+    switches the kernels over to eight samples at a time. DistortionAO also builds
+    its kernels a second time with AVX2 in DistortionKernelsAvx2.cpp and picks
+    that copy at run time when the CPU has it, so the SSE2 build gets the wider
+    registers too.
+
+    There is a double version of each set for the double precision path, with
+    half as many lanes: two on SSE2 and 64 bit NEON, four on AVX2.
+*/
+namespace SimdOps
+{
+inline namespace SIMDOPS_TARGET
+{
+    /** Plain floats or doubles, used for the tail of each block and on platforms without SIMD. */
+    template <typename SampleType>
+    struct ScalarOps
+    {
+        using Sample = SampleType;
+        using Vec = SampleType;
+        using Mask = bool;
+        static constexpr int width = 1;
+
+        static Vec load (const Sample* source) noexcept       { return *source; }
+        static void store (Sample* dest, Vec value) noexcept  { *dest = value; }
+        static Vec set (Sample value) noexcept                { return value; }
+
+        static Vec add (Vec a, Vec b) noexcept                { return a + b; }
+        static Vec sub (Vec a, Vec b) noexcept                { return a - b; }
+        static Vec mul (Vec a, Vec b) noexcept                { return a * b; }
+        static Vec div (Vec a, Vec b) noexcept                { return a / b; }
+        static Vec min (Vec a, Vec b) noexcept                { return b < a ? b : a; }
+        static Vec max (Vec a, Vec b) noexcept                { return a < b ? b : a; }
+        static Vec abs (Vec a) noexcept                       { return std::abs (a); }
+        static Vec copySign (Vec magnitude, Vec sign) noexcept { return std::copysign (magnitude, sign); }
+
+        static Mask greaterThan (Vec a, Vec b) noexcept       { return a > b; }
+        static Vec select (Mask mask, Vec a, Vec b) noexcept  { return mask ? a : b; }
+
+        /** Rounds to the nearest whole number, only valid for values smaller than 2^22 (2^51 for doubles). */
+        static Vec round (Vec a) noexcept
+        {
+            const auto magic = std::is_same_v<Sample, double> ? (Sample) 6755399441055744.0 : (Sample) 12582912.0;
+            return (a + magic) - magic;
+        }
+
+        /** Returns 2^n for a whole number n between -126 and 127 (-1022 and 1023 for doubles). */
+        static Vec exp2Int (Vec n) noexcept
+        {
+            if constexpr (std::is_same_v<Sample, double>)
+                return std::bit_cast<double> (((std::int64_t) n + 1023) << 52);
+            else
+                return std::bit_cast<float> (((std::int32_t) n + 127) << 23);
+        }
+    };
+
+    using Scalar = ScalarOps<float>;
+    using ScalarDouble = ScalarOps<double>;
+
+   #if JUCE_INTEL
+    /** Four floats in an SSE2 register, which every x86 target JUCE supports has. */
+    struct Sse
+    {
+        using Sample = float;
+        using Vec = __m128;
+        using Mask = __m128;
+        static constexpr int width = 4;
+
+        static Vec load (const float* source) noexcept        { return _mm_loadu_ps (source); }
+        static void store (float* dest, Vec value) noexcept   { _mm_storeu_ps (dest, value); }
+        static Vec set (float value) noexcept                 { return _mm_set1_ps (value); }
+
+        static Vec add (Vec a, Vec b) noexcept                { return _mm_add_ps (a, b); }
+        static Vec sub (Vec a, Vec b) noexcept                { return _mm_sub_ps (a, b); }
+        static Vec mul (Vec a, Vec b) noexcept                { return _mm_mul_ps (a, b); }
+        static Vec div (Vec a, Vec b) noexcept                { return _mm_div_ps (a, b); }
+        static Vec min (Vec a, Vec b) noexcept                { return _mm_min_ps (a, b); }
+        static Vec max (Vec a, Vec b) noexcept                { return _mm_max_ps (a, b); }
+        static Vec abs (Vec a) noexcept                       { return _mm_andnot_ps (_mm_set1_ps (-0.0f), a); }
+
+        static Vec copySign (Vec magnitude, Vec sign) noexcept
+        {
+            auto signBit = _mm_set1_ps (-0.0f);
+            return _mm_or_ps (_mm_andnot_ps (signBit, magnitude), _mm_and_ps (signBit, sign));
+        }
+
+        static Mask greaterThan (Vec a, Vec b) noexcept       { return _mm_cmpgt_ps (a, b); }
+        static Vec select (Mask mask, Vec a, Vec b) noexcept  { return _mm_or_ps (_mm_and_ps (mask, a), _mm_andnot_ps (mask, b)); }
+
+        static Vec round (Vec a) noexcept                     { return _mm_cvtepi32_ps (_mm_cvtps_epi32 (a)); }
+
+        static Vec exp2Int (Vec n) noexcept
+        {
+            return _mm_castsi128_ps (_mm_slli_epi32 (_mm_add_epi32 (_mm_cvtps_epi32 (n), _mm_set1_epi32 (127)), 23));
+        }
+    };
+
+    /** Two doubles in an SSE2 register. */
+    struct SseDouble
+    {
+        using Sample = double;
+        using Vec = __m128d;
+        using Mask = __m128d;
+        static constexpr int width = 2;
+
+        static Vec load (const double* source) noexcept       { return _mm_loadu_pd (source); }
+        static void store (double* dest, Vec value) noexcept  { _mm_storeu_pd (dest, value); }
+        static Vec set (double value) noexcept                { return _mm_set1_pd (value); }
+
+        static Vec add (Vec a, Vec b) noexcept                { return _mm_add_pd (a, b); }
+        static Vec sub (Vec a, Vec b) noexcept                { return _mm_sub_pd (a, b); }
+        static Vec mul (Vec a, Vec b) noexcept                { return _mm_mul_pd (a, b); }
+        static Vec div (Vec a, Vec b) noexcept                { return _mm_div_pd (a, b); }
+        static Vec min (Vec a, Vec b) noexcept                { return _mm_min_pd (a, b); }
+        static Vec max (Vec a, Vec b) noexcept                { return _mm_max_pd (a, b); }
+        static Vec abs (Vec a) noexcept                       { return _mm_andnot_pd (_mm_set1_pd (-0.0), a); }
+
+        static Vec copySign (Vec magnitude, Vec sign) noexcept
+        {
+            auto signBit = _mm_set1_pd (-0.0);
+            return _mm_or_pd (_mm_andnot_pd (signBit, magnitude), _mm_and_pd (signBit, sign));
+        }
+
+        static Mask greaterThan (Vec a, Vec b) noexcept       { return _mm_cmpgt_pd (a, b); }
+        static Vec select (Mask mask, Vec a, Vec b) noexcept  { return _mm_or_pd (_mm_and_pd (mask, a), _mm_andnot_pd (mask, b)); }
+
+        // SSE2 has no double rounding instruction, so this goes through 32 bit integers and back.
+        static Vec round (Vec a) noexcept                     { return _mm_cvtepi32_pd (_mm_cvtpd_epi32 (a)); }
+
+        static Vec exp2Int (Vec n) noexcept
+        {
+            // n + 1023 is never negative here, so widening it to 64 bits is just interleaving with zeros.
+            auto biased = _mm_add_epi32 (_mm_cvtpd_epi32 (n), _mm_set1_epi32 (1023));
+            return _mm_castsi128_pd (_mm_slli_epi64 (_mm_unpacklo_epi32 (biased, _mm_setzero_si128()), 52));
+        }
+    };
+
+   #if defined (__AVX2__)
+    /** Eight floats in an AVX register, only used when the compiler is allowed to target AVX2. */
+    struct Avx
+    {
+        using Sample = float;
+        using Vec = __m256;
+        using Mask = __m256;
+        static constexpr int width = 8;
+
+        static Vec load (const float* source) noexcept        { return _mm256_loadu_ps (source); }
+        static void store (float* dest, Vec value) noexcept   { _mm256_storeu_ps (dest, value); }
+        static Vec set (float value) noexcept                 { return _mm256_set1_ps (value); }
+
+        static Vec add (Vec a, Vec b) noexcept                { return _mm256_add_ps (a, b); }
+        static Vec sub (Vec a, Vec b) noexcept                { return _mm256_sub_ps (a, b); }
+        static Vec mul (Vec a, Vec b) noexcept                { return _mm256_mul_ps (a, b); }
+        static Vec div (Vec a, Vec b) noexcept                { return _mm256_div_ps (a, b); }
+        static Vec min (Vec a, Vec b) noexcept                { return _mm256_min_ps (a, b); }
+        static Vec max (Vec a, Vec b) noexcept                { return _mm256_max_ps (a, b); }
+        static Vec abs (Vec a) noexcept                       { return _mm256_andnot_ps (_mm256_set1_ps (-0.0f), a); }
+
+        static Vec copySign (Vec magnitude, Vec sign) noexcept
+        {
+            auto signBit = _mm256_set1_ps (-0.0f);
+            return _mm256_or_ps (_mm256_andnot_ps (signBit, magnitude), _mm256_and_ps (signBit, sign));
+        }
+
+        static Mask greaterThan (Vec a, Vec b) noexcept       { return _mm256_cmp_ps (a, b, _CMP_GT_OQ); }
+        static Vec select (Mask mask, Vec a, Vec b) noexcept  { return _mm256_blendv_ps (b, a, mask); }
+
+        static Vec round (Vec a) noexcept                     { return _mm256_round_ps (a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        static Vec exp2Int (Vec n) noexcept
+        {
+            return _mm256_castsi256_ps (_mm256_slli_epi32 (_mm256_add_epi32 (_mm256_cvtps_epi32 (n), _mm256_set1_epi32 (127)), 23));
+        }
+    };
+
+    /** Four doubles in an AVX register, only used when the compiler is allowed to target AVX2. */
+    struct AvxDouble
+    {
+        using Sample = double;
+        using Vec = __m256d;
+        using Mask = __m256d;
+        static constexpr int width = 4;
+
+        static Vec load (const double* source) noexcept       { return _mm256_loadu_pd (source); }
+        static void store (double* dest, Vec value) noexcept  { _mm256_storeu_pd (dest, value); }
+        static Vec set (double value) noexcept                { return _mm256_set1_pd (value); }
+
+        static Vec add (Vec a, Vec b) noexcept                { return _mm256_add_pd (a, b); }
+        static Vec sub (Vec a, Vec b) noexcept                { return _mm256_sub_pd (a, b); }
+        static Vec mul (Vec a, Vec b) noexcept                { return _mm256_mul_pd (a, b); }
+        static Vec div (Vec a, Vec b) noexcept                { return _mm256_div_pd (a, b); }
+        static Vec min (Vec a, Vec b) noexcept                { return _mm256_min_pd (a, b); }
+        static Vec max (Vec a, Vec b) noexcept                { return _mm256_max_pd (a, b); }
+        static Vec abs (Vec a) noexcept                       { return _mm256_andnot_pd (_mm256_set1_pd (-0.0), a); }
+
+        static Vec copySign (Vec magnitude, Vec sign) noexcept
+        {
+            auto signBit = _mm256_set1_pd (-0.0);
+            return _mm256_or_pd (_mm256_andnot_pd (signBit, magnitude), _mm256_and_pd (signBit, sign));
+        }
+
+        static Mask greaterThan (Vec a, Vec b) noexcept       { return _mm256_cmp_pd (a, b, _CMP_GT_OQ); }
+        static Vec select (Mask mask, Vec a, Vec b) noexcept  { return _mm256_blendv_pd (b, a, mask); }
+
+        static Vec round (Vec a) noexcept                     { return _mm256_round_pd (a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        static Vec exp2Int (Vec n) noexcept
+        {
+            auto biased = _mm_add_epi32 (_mm256_cvtpd_epi32 (n), _mm_set1_epi32 (1023));
+            return _mm256_castsi256_pd (_mm256_slli_epi64 (_mm256_cvtepi32_epi64 (biased), 52));
+        }
+    };
+
+    using Native = Avx;
+    using NativeDouble = AvxDouble;
+   #else
+    using Native = Sse;
+    using NativeDouble = SseDouble;
+   #endif
+   #elif SIMDOPS_USE_NEON
+    /** Four floats in a NEON register. */
+    struct Neon
+    {
+        using Sample = float;
+        using Vec = float32x4_t;
+        using Mask = uint32x4_t;
+        static constexpr int width = 4;
+
+        static Vec load (const float* source) noexcept        { return vld1q_f32 (source); }
+        static void store (float* dest, Vec value) noexcept   { vst1q_f32 (dest, value); }
+        static Vec set (float value) noexcept                 { return vdupq_n_f32 (value); }
+
+        static Vec add (Vec a, Vec b) noexcept                { return vaddq_f32 (a, b); }
+        static Vec sub (Vec a, Vec b) noexcept                { return vsubq_f32 (a, b); }
+        static Vec mul (Vec a, Vec b) noexcept                { return vmulq_f32 (a, b); }
+
+        static Vec div (Vec a, Vec b) noexcept
+        {
+           #if defined (__aarch64__)
+            return vdivq_f32 (a, b);
+           #else
+            // 32 bit NEON has no divide, so refine the reciprocal estimate twice, which is close enough to a true divide.
+            auto reciprocal = vrecpeq_f32 (b);
+            reciprocal = vmulq_f32 (vrecpsq_f32 (b, reciprocal), reciprocal);
+            reciprocal = vmulq_f32 (vrecpsq_f32 (b, reciprocal), reciprocal);
+            return vmulq_f32 (a, reciprocal);
+           #endif
+        }
+
+        static Vec min (Vec a, Vec b) noexcept                { return vminq_f32 (a, b); }
+        static Vec max (Vec a, Vec b) noexcept                { return vmaxq_f32 (a, b); }
+        static Vec abs (Vec a) noexcept                       { return vabsq_f32 (a); }
+        static Vec copySign (Vec magnitude, Vec sign) noexcept { return vbslq_f32 (vdupq_n_u32 (0x80000000u), sign, magnitude); }
+
+        static Mask greaterThan (Vec a, Vec b) noexcept       { return vcgtq_f32 (a, b); }
+        static Vec select (Mask mask, Vec a, Vec b) noexcept  { return vbslq_f32 (mask, a, b); }
+
+        static Vec round (Vec a) noexcept
+        {
+            auto magic = vdupq_n_f32 (12582912.0f);
+            return vsubq_f32 (vaddq_f32 (a, magic), magic);
+        }
+
+        static Vec exp2Int (Vec n) noexcept
+        {
+            return vreinterpretq_f32_s32 (vshlq_n_s32 (vaddq_s32 (vcvtq_s32_f32 (n), vdupq_n_s32 (127)), 23));
+        }
+    };
+
+    using Native = Neon;
+
+   #if defined (__aarch64__)
+    /** Two doubles in a NEON register, which only 64 bit ARM has. */
+    struct NeonDouble
+    {
+        using Sample = double;
+        using Vec = float64x2_t;
+        using Mask = uint64x2_t;
+        static constexpr int width = 2;
+
+        static Vec load (const double* source) noexcept       { return vld1q_f64 (source); }
+        static void store (double* dest, Vec value) noexcept  { vst1q_f64 (dest, value); }
+        static Vec set (double value) noexcept                { return vdupq_n_f64 (value); }
+
+        static Vec add (Vec a, Vec b) noexcept                { return vaddq_f64 (a, b); }
+        static Vec sub (Vec a, Vec b) noexcept                { return vsubq_f64 (a, b); }
+        static Vec mul (Vec a, Vec b) noexcept                { return vmulq_f64 (a, b); }
+        static Vec div (Vec a, Vec b) noexcept                { return vdivq_f64 (a, b); }
+        static Vec min (Vec a, Vec b) noexcept                { return vminq_f64 (a, b); }
+        static Vec max (Vec a, Vec b) noexcept                { return vmaxq_f64 (a, b); }
+        static Vec abs (Vec a) noexcept                       { return vabsq_f64 (a); }
+        static Vec copySign (Vec magnitude, Vec sign) noexcept { return vbslq_f64 (vdupq_n_u64 (0x8000000000000000ull), sign, magnitude); }
+
+        static Mask greaterThan (Vec a, Vec b) noexcept       { return vcgtq_f64 (a, b); }
+        static Vec select (Mask mask, Vec a, Vec b) noexcept  { return vbslq_f64 (mask, a, b); }
+
+        static Vec round (Vec a) noexcept                     { return vrndnq_f64 (a); }
+
+        static Vec exp2Int (Vec n) noexcept
+        {
+            return vreinterpretq_f64_s64 (vshlq_n_s64 (vaddq_s64 (vcvtq_s64_f64 (n), vdupq_n_s64 (1023)), 52));
+        }
+    };
+
+    using NativeDouble = NeonDouble;
+   #else
+    using NativeDouble = ScalarDouble;
+   #endif
+   #else
+    using Native = Scalar;
+    using NativeDouble = ScalarDouble;
+   #endif
+
+    /** The widest ops for a sample type, so a kernel can be written once for floats and doubles. */
+    template <typename SampleType>
+    using NativeFor = std::conditional_t<std::is_same_v<SampleType, double>, NativeDouble, Native>;
+
+    template <typename SampleType>
+    using ScalarFor = ScalarOps<SampleType>;
+
+    //==============================================================================
+    /** A polynomial exp() for inputs that are zero or below.
+
+        This is the usual range reduction, x = n * ln(2) + r, followed by a Taylor
+        series for e^r and building 2^n straight into the exponent bits. The float
+        version stays within 3e-7 of std::exp, the double version uses more terms
+        and stays within 1e-14. Unlike std::exp, it runs on every lane at once.
+    */
+    template <typename Ops>
+    inline typename Ops::Vec expNegative (typename Ops::Vec x) noexcept
+    {
+        using Sample = typename Ops::Sample;
+
+        if constexpr (std::is_same_v<Sample, double>)
+        {
+            // Anything below this would be a denormal, which is as good as zero here.
+            x = Ops::max (x, Ops::set (-708.0));
+
+            auto n = Ops::round (Ops::mul (x, Ops::set (1.4426950408889634)));
+
+            // ln(2) is split in two so that r keeps its precision.
+            auto r = Ops::sub (x, Ops::mul (n, Ops::set (6.93145751953125e-1)));
+            r = Ops::sub (r, Ops::mul (n, Ops::set (1.42860682030941723212e-6)));
+
+            // 1 / 11! down to 1 / 2!, then 1 and 1.
+            static constexpr double coefficients[] = { 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0,
+                                                       1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0 };
+
+            auto p = Ops::set (coefficients[0]);
+
+            for (size_t i = 1; i < std::size (coefficients); ++i)
+                p = Ops::add (Ops::mul (p, r), Ops::set (coefficients[i]));
+
+            return Ops::mul (p, Ops::exp2Int (n));
+        }
+        else
+        {
+            // Anything below this would be a denormal, which is as good as zero here.
+            x = Ops::max (x, Ops::set (-87.0f));
+
+            auto n = Ops::round (Ops::mul (x, Ops::set (1.44269504f)));
+
+            // ln(2) is split in two so that r keeps its precision.
+            auto r = Ops::sub (x, Ops::mul (n, Ops::set (0.693359375f)));
+            r = Ops::add (r, Ops::mul (n, Ops::set (2.12194440e-4f)));
+
+            auto p = Ops::set (1.0f / 720.0f);
+            p = Ops::add (Ops::mul (p, r), Ops::set (1.0f / 120.0f));
+            p = Ops::add (Ops::mul (p, r), Ops::set (1.0f / 24.0f));
+            p = Ops::add (Ops::mul (p, r), Ops::set (1.0f / 6.0f));
+            p = Ops::add (Ops::mul (p, r), Ops::set (0.5f));
+            p = Ops::add (Ops::mul (p, r), Ops::set (1.0f));
+            p = Ops::add (Ops::mul (p, r), Ops::set (1.0f));
+
+            return Ops::mul (p, Ops::exp2Int (n));
+        }
+    }
+}
+}